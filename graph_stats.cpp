@@ -7,6 +7,7 @@
 #include "yaml-cpp/node/parse.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
 
 FPMAS_BASE_DATAPACK_SET_UP(
 		GridCell::JsonBase,
@@ -55,6 +56,12 @@ int main(int argc, char** argv) {
 		YAML::Node config = YAML::LoadFile(config_file);
 		for(auto env_node : config) {
 			GraphConfig graph_config(env_node);
+			graph_config.seed = seed;
+			graph_config.applyWeakScaling(fpmas::communication::WORLD.getSize());
+			graph_config.validate();
+			if(!graph_config.is_valid)
+				// The configuration is the same on all processes
+				continue;
 
 			MetaModelFactory model_factory(
 					graph_config.environment, SyncMode::GHOST_MODE);
@@ -72,6 +79,9 @@ int main(int argc, char** argv) {
 			std::transform(
 					env_name.begin(), env_name.end(), env_name.begin(),
 					[] (const char& c) {return std::tolower(c);});
+			if(graph_config.weakScaling())
+				env_name += "-n" + std::to_string(
+						fpmas::communication::WORLD.getSize());
 
 			fpmas::scheduler::Scheduler scheduler;
 			fpmas::runtime::Runtime runtime(scheduler);
@@ -90,6 +100,11 @@ int main(int argc, char** argv) {
 				GraphStatsOutput(*model, env_name + ".csv").dump();
 
 			delete model;
+			// The MetaModel CSV output is not relevant
+			std::string rank = std::to_string(
+					fpmas::communication::WORLD.getRank());
+			std::remove((env_name + "." + rank + ".csv.part").c_str());
+			std::remove((env_name + ".warmup." + rank + ".csv.part").c_str());
 		}
 	}
 	fpmas::finalize();
@@ -27,7 +27,8 @@ struct MovePolicyFunction {
  * MovePolicyFunction implementation: selects a random cell from the mobility
  * field.
  *
- * The probability to select each cell is proportional to its utility.
+ * The probability to select each cell is proportional to its effective
+ * utility.
  */
 template<typename CellType>
 struct RandomMovePolicy : public MovePolicyFunction<CellType> {
@@ -36,8 +37,8 @@ struct RandomMovePolicy : public MovePolicyFunction<CellType> {
 };
 
 /**
- * MovePolicyFunction implementation: selects the cell with the maximum utility
- * from the mobility field. If several cells have the same maximum utility, a
+ * MovePolicyFunction implementation: selects the cell with the maximum effective
+ * utility from the mobility field. If several cells have the same maximum utility, a
  * random cell is chosen among them.
  */
 template<typename CellType>
@@ -55,9 +56,9 @@ CellType* RandomMovePolicy<CellType>::selectCell(
 	bool null_utilities = true;
 	for(auto cell : mobility_field) {
 		fpmas::model::ReadGuard read(cell);
-		if(cell->getUtility() > 0)
+		if(cell->effectiveUtility() > 0)
 			null_utilities = false;
-		utilities.push_back(cell->getUtility());
+		utilities.push_back(cell->effectiveUtility());
 		cells.push_back(cell);
 	}
 	std::size_t rd_index;
@@ -80,7 +81,7 @@ CellType* MaxMovePolicy<CellType>::selectCell(
 	std::vector<std::pair<CellType*, float>> cells;
 	for(auto cell : mobility_field) {
 		fpmas::model::ReadGuard read(cell);
-		cells.push_back({cell, cell->getUtility()});
+		cells.push_back({cell, cell->effectiveUtility()});
 	}
 
 	return std::max_element(cells.begin(), cells.end(),
@@ -123,8 +124,54 @@ class MetaAgentBase {
 		 * time step.
 		 */
 		static MovePolicy move_policy;
+		/**
+		 * Species of agents, loaded from the configuration. If empty, all
+		 * agents use the global static fields above.
+		 *
+		 * @see ModelConfig::species
+		 */
+		static std::vector<Species> species_table;
+		/**
+		 * Maximum count of species, so that the species index of each agent
+		 * is serialized on a single byte.
+		 */
+		static const std::size_t max_species = 256;
+		/**
+		 * Interactions performed by each agent with its contacts at each
+		 * time step, to propagate the infection state along CONTACT edges.
+		 *
+		 * Interactions that perform writes require the HARD_SYNC_MODE
+		 * sync_mode, since writes to DISTANT contacts only modify their ghost
+		 * copy in other modes.
+		 *
+		 * @see MetaAgent::gossip()
+		 */
+		static Interactions contact_interactions;
+		/**
+		 * Probability that an infected agent infects a contact it reads or
+		 * writes.
+		 */
+		static float infection_rate;
+		/**
+		 * Probability that an infected agent recovers at each time step.
+		 */
+		static float recovery_rate;
+		/**
+		 * Fraction of agents infected at initialization.
+		 */
+		static float initial_infected;
+
+		/**
+		 * Range size of agents of the specified species.
+		 */
+		static std::size_t rangeSize(std::size_t species);
 	private:
 		std::deque<DistributedId> _contacts;
+		fpmas::api::scheduler::TimeStep birth = 0;
+		float _workload = 0;
+		std::uint8_t _species = 0;
+		bool _infected = false;
+		bool _next_infected = false;
 	protected:
 		/**
 		 * Non-const contacts() access, that can only be used internally during
@@ -156,14 +203,129 @@ class MetaAgentBase {
 		 * MetaAgentBase constructor.
 		 *
 		 * @param contacts Initial list of contacts
+		 * @param birth Time step at which the agent was spawned
 		 */
-		MetaAgentBase(const std::deque<DistributedId>& contacts)
-			: _contacts(contacts) {}
+		MetaAgentBase(
+				const std::deque<DistributedId>& contacts,
+				fpmas::api::scheduler::TimeStep birth)
+			: _contacts(contacts), birth(birth) {}
+		/**
+		 * MetaAgentBase constructor.
+		 *
+		 * @param contacts Initial list of contacts
+		 * @param birth Time step at which the agent was spawned
+		 * @param species Index of the species of the agent in #species_table
+		 */
+		MetaAgentBase(
+				const std::deque<DistributedId>& contacts,
+				fpmas::api::scheduler::TimeStep birth,
+				std::size_t species)
+			: _contacts(contacts), birth(birth), _species(species) {}
 
 		/**
 		 * Current contacts of the agent.
 		 */
 		const std::deque<DistributedId>& contacts() const;
+
+		/**
+		 * Time step at which the agent was spawned.
+		 *
+		 * If ModelConfig::lifespan is specified, agents built at
+		 * initialization are given birth dates uniformly distributed over
+		 * the `lifespan` time steps preceding the time step 0. Such dates
+		 * wrap around the TimeStep range, so the age of an agent must be
+		 * computed as `time_step - birthDate()`.
+		 *
+		 * @see ModelConfig::lifespan
+		 */
+		fpmas::api::scheduler::TimeStep birthDate() const {
+			return birth;
+		}
+		/**
+		 * Sets the time step at which the agent was spawned.
+		 */
+		void setBirthDate(fpmas::api::scheduler::TimeStep birth) {
+			this->birth = birth;
+		}
+
+		/**
+		 * Count of floating point operations performed by the
+		 * workload_kernel() at each move.
+		 *
+		 * @see ModelConfig::agent_workload
+		 */
+		float workload() const {
+			return _workload;
+		}
+		/**
+		 * Sets the workload of the agent.
+		 */
+		void setWorkload(float workload) {
+			this->_workload = workload;
+		}
+
+		/**
+		 * Index of the species of the agent in #species_table.
+		 */
+		std::size_t species() const {
+			return _species;
+		}
+		/**
+		 * Perception and mobility range size of the agent.
+		 */
+		std::size_t rangeSize() const {
+			return rangeSize(_species);
+		}
+		/**
+		 * Maximum number of contacts of the agent.
+		 */
+		std::size_t maxContacts() const;
+		/**
+		 * Weight of edges from the agent to its contacts.
+		 */
+		float contactWeight() const;
+		/**
+		 * MovePolicy of the agent.
+		 */
+		MovePolicy movePolicy() const;
+
+		/**
+		 * True iff the agent is currently infected.
+		 */
+		bool infected() const {
+			return _infected;
+		}
+		/**
+		 * True iff the agent will be infected from the next time step, unless
+		 * it recovers.
+		 */
+		bool nextInfected() const {
+			return _next_infected;
+		}
+		/**
+		 * Sets the current and next infection states of the agent.
+		 */
+		void setInfected(bool infected, bool next_infected) {
+			this->_infected = infected;
+			this->_next_infected = next_infected;
+		}
+		/**
+		 * Infects the agent from the next time step, so that contacts read
+		 * during the current time step are not affected.
+		 *
+		 * This method can be called on a DISTANT agent after an _acquire_
+		 * operation.
+		 */
+		void infect() {
+			this->_next_infected = true;
+		}
+		/**
+		 * Commits the infection state computed during the current time step.
+		 *
+		 * @param recover If true and the agent is currently infected, the
+		 * agent becomes susceptible again
+		 */
+		void commitInfection(bool recover);
 };
 
 /**
@@ -192,14 +354,26 @@ class MetaAgent : public AgentBase, public MetaAgentBase {
 		/**
 		 * MetaAgent default constructor.
 		 */
-		MetaAgent() : range(range_size) {}
+		MetaAgent() : range(rangeSize()) {}
+		/**
+		 * MetaAgent constructor.
+		 *
+		 * @param species Index of the species of the agent
+		 */
+		MetaAgent(std::size_t species)
+			: MetaAgentBase({}, 0, species), range(rangeSize()) {}
 		/**
 		 * MetaAgent constructor.
 		 *
 		 * @param contacts Initial list of contacts
+		 * @param birth Time step at which the agent was spawned
+		 * @param species Index of the species of the agent
 		 */
-		MetaAgent(const std::deque<DistributedId>& contacts)
-			: MetaAgentBase(contacts), range(range_size) {}
+		MetaAgent(
+				const std::deque<DistributedId>& contacts,
+				fpmas::api::scheduler::TimeStep birth,
+				std::size_t species = 0)
+			: MetaAgentBase(contacts, birth, species), range(rangeSize()) {}
 
 		/**
 		 * FPMAS mobility range set up.
@@ -237,9 +411,21 @@ class MetaAgent : public AgentBase, public MetaAgentBase {
 		 */
 		void handle_new_contacts();
 		/**
-		 * Moves to the next cell according to the current MovePolicy.
+		 * Executes the workload_kernel() with the workload of the agent, and
+		 * moves to the next cell according to the current MovePolicy.
 		 */
 		void move();
+		/**
+		 * Interacts with contacts according to #contact_interactions, to
+		 * propagate the infection state along CONTACT edges (SIS model).
+		 *
+		 * Each infected contact read exposes this agent to an infection with
+		 * a probability #infection_rate, and each contact written by an
+		 * infected agent is infected with the same probability. New
+		 * infections take effect when commitInfection() is called at the end
+		 * of the time step.
+		 */
+		void gossip();
 
 		const fpmas::api::model::AgentNode* agentNode() const override {
 			return this->AgentBase::node();
@@ -248,7 +434,7 @@ class MetaAgent : public AgentBase, public MetaAgentBase {
 
 template<typename AgentBase, typename PerceptionRange>
 void MetaAgent<AgentBase, PerceptionRange>::add_to_contacts(fpmas::api::model::Agent* agent) {
-	if(contacts().size() == max_contacts) {
+	if(contacts().size() == maxContacts()) {
 		for(auto edge : this->node()->getOutgoingEdges(CONTACT)) {
 			// Finds the edge corresponding to the queue's head and unlinks it
 			if(edge->getTargetNode()->getId() == contacts().front()) {
@@ -261,7 +447,7 @@ void MetaAgent<AgentBase, PerceptionRange>::add_to_contacts(fpmas::api::model::A
 		contacts().pop_front();
 	}
 	// Links the new contact...
-	this->model()->link(this, agent, CONTACT)->setWeight(MetaAgentBase::contact_weight);
+	this->model()->link(this, agent, CONTACT)->setWeight(contactWeight());
 	// ... and adds it at the end of the queue
 	contacts().push_back(agent->node()->getId());
 }
@@ -336,9 +522,10 @@ void MetaAgent<AgentBase, PerceptionRange>::handle_new_contacts() {
 
 template<typename AgentBase, typename PerceptionRange>
 void MetaAgent<AgentBase, PerceptionRange>::move() {
+	workload_kernel(this->workload());
 	auto mobility_field = this->mobilityField();
 	typename AgentBase::Cell* selected_cell;
-	switch(move_policy) {
+	switch(movePolicy()) {
 		case MovePolicy::RANDOM:
 			selected_cell = RandomMovePolicy<typename AgentBase::Cell>()
 				.selectCell(mobility_field);
@@ -352,10 +539,31 @@ void MetaAgent<AgentBase, PerceptionRange>::move() {
 	this->moveTo(selected_cell);
 }
 
+template<typename AgentBase, typename PerceptionRange>
+void MetaAgent<AgentBase, PerceptionRange>::gossip() {
+	auto contacts = this->template outNeighbors<fpmas::api::model::Agent>(CONTACT);
+	fpmas::random::UniformRealDistribution<float> draw(0, 1);
+	InteractionCallbacks callbacks;
+	callbacks.read = [this, &draw] (const fpmas::api::model::Agent* contact) {
+		if(dynamic_cast<const MetaAgentBase*>(contact)->infected()
+				&& draw(random_interactions) < infection_rate)
+			this->infect();
+	};
+	if(this->infected())
+		callbacks.write = [&draw] (fpmas::api::model::Agent* contact) {
+			if(draw(random_interactions) < infection_rate)
+				dynamic_cast<MetaAgentBase*>(contact)->infect();
+		};
+	ReaderWriter::interact(
+			contact_interactions, contacts, callbacks,
+			ReaderWriter::contact_probes);
+}
+
 /**
  * MetaAgent JSON and ObjectPack serialization rules.
  *
- * Only the list of contacts needs to be serialized, all other fields are
+ * Only the list of contacts, the birth date, the workload, the species index
+ * and the infection state need to be serialized, all other fields are
  * automatically handled by FPMAS.
  */
 template<typename AgentType>
@@ -386,30 +594,90 @@ struct MetaAgentSerialization {
 
 template<typename AgentType>
 void MetaAgentSerialization<AgentType>::to_json(nlohmann::json& j, const AgentType* agent) {
-	j = agent->contacts();
+	j = {agent->contacts(), agent->birthDate(), agent->workload(),
+		agent->species(), agent->infected(), agent->nextInfected()};
 }
 
 template<typename AgentType>
 AgentType* MetaAgentSerialization<AgentType>::from_json(const nlohmann::json& j) {
-	return new AgentType(j.get<std::deque<DistributedId>>());
+	AgentType* agent = new AgentType(
+			j[0].get<std::deque<DistributedId>>(),
+			j[1].get<fpmas::api::scheduler::TimeStep>(),
+			j[3].get<std::size_t>());
+	agent->setWorkload(j[2].get<float>());
+	agent->setInfected(j[4].get<bool>(), j[5].get<bool>());
+	return agent;
 }
 
 template<typename AgentType>
 std::size_t MetaAgentSerialization<AgentType>::size(
 		const fpmas::io::datapack::ObjectPack &o, const AgentType *agent) {
-	return o.size(agent->contacts());
+	return o.size(agent->contacts())
+		+ o.size<fpmas::api::scheduler::TimeStep>() + o.size<float>()
+		+ 2 * o.size<std::uint8_t>();
 }
 
 template<typename AgentType>
 void MetaAgentSerialization<AgentType>::to_datapack(
 		fpmas::io::datapack::ObjectPack& o, const AgentType* agent) {
 	o.put(agent->contacts());
+	o.put(agent->birthDate());
+	o.put(agent->workload());
+	o.put((std::uint8_t) agent->species());
+	// Both infection states are packed in a single byte
+	o.put((std::uint8_t) (agent->infected() | agent->nextInfected() << 1));
 }
 
 template<typename AgentType>
 AgentType* MetaAgentSerialization<AgentType>::from_datapack(
 		const fpmas::io::datapack::ObjectPack &o) {
-	return new AgentType(o.get<std::deque<DistributedId>>());
+	std::deque<DistributedId> contacts = o.get<std::deque<DistributedId>>();
+	fpmas::api::scheduler::TimeStep birth
+		= o.get<fpmas::api::scheduler::TimeStep>();
+	float workload = o.get<float>();
+	AgentType* agent = new AgentType(contacts, birth, o.get<std::uint8_t>());
+	agent->setWorkload(workload);
+	std::uint8_t infection = o.get<std::uint8_t>();
+	agent->setInfected(infection & 1, infection & 2);
+	return agent;
+}
+
+/**
+ * A SpatialAgentFactory that builds agents of random species, drawn according
+ * to the fractions of MetaAgentBase::species_table.
+ */
+template<typename AgentType>
+class SpeciesAgentFactory :
+	public fpmas::api::model::SpatialAgentFactory<typename AgentType::Cell> {
+	private:
+		fpmas::random::DiscreteDistribution<std::size_t> species_distribution;
+
+		static std::vector<float> fractions();
+
+	public:
+		/**
+		 * SpeciesAgentFactory constructor.
+		 */
+		SpeciesAgentFactory() : species_distribution(fractions()) {
+		}
+
+		/**
+		 * Builds an agent of a random species.
+		 */
+		AgentType* build() override {
+			return new AgentType(
+					species_distribution(fpmas::model::RandomNeighbors::rd));
+		}
+};
+
+template<typename AgentType>
+std::vector<float> SpeciesAgentFactory<AgentType>::fractions() {
+	if(MetaAgentBase::species_table.empty())
+		return {1.f};
+	std::vector<float> fractions;
+	for(auto& species : MetaAgentBase::species_table)
+		fractions.push_back(species.fraction);
+	return fractions;
 }
 
 /**
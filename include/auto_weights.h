@@ -0,0 +1,119 @@
+#pragma once
+
+#include "fpmas.h"
+#include <chrono>
+#include <unordered_map>
+
+/**
+ * @file auto_weights.h
+ * Contains features used to derive node weights from measured execution
+ * times.
+ */
+
+/**
+ * Accumulates the measured cost of each LOCAL node, and derives node weights
+ * from those costs.
+ *
+ * The cost of each node is the sum of the execution times of its behaviors
+ * during a time step, smoothed over time steps with an exponential moving
+ * average. Costs are stored by DistributedId, so that no data needs to be
+ * serialized with agents: the cost of a node that migrates is measured again
+ * from scratch by its new process.
+ *
+ * @see ModelConfig::auto_weights
+ */
+class AutoWeights {
+	public:
+		/**
+		 * Clock used to measure execution times.
+		 */
+		typedef std::chrono::steady_clock Clock;
+		/**
+		 * Minimum weight assigned to nodes, so that nodes without behaviors
+		 * are still taken into account by load balancing algorithms.
+		 */
+		static const float min_weight;
+
+	private:
+		float smoothing;
+		float communication_cost;
+		// Costs measured during the current time step, in microseconds
+		std::unordered_map<fpmas::api::graph::DistributedId, double> step_costs;
+		// Smoothed costs, in microseconds
+		std::unordered_map<fpmas::api::graph::DistributedId, double> costs;
+
+	public:
+		/**
+		 * AutoWeights constructor.
+		 *
+		 * @param smoothing Weight of the last time step in the exponential
+		 * moving average, in ]0, 1]
+		 * @param communication_cost Cost added to the weight of a node for
+		 * each of its outgoing DISTANT edges, in microseconds
+		 */
+		AutoWeights(float smoothing, float communication_cost)
+			: smoothing(smoothing), communication_cost(communication_cost) {
+			}
+
+		/**
+		 * Adds the specified duration to the cost of the node during the
+		 * current time step. Not thread safe.
+		 *
+		 * @param id Id of the node
+		 * @param duration Execution time of a behavior of the node
+		 */
+		void record(
+				fpmas::api::graph::DistributedId id, Clock::duration duration);
+
+		/**
+		 * Folds the costs measured during the current time step into the
+		 * smoothed costs of LOCAL nodes of the graph, and starts a new time
+		 * step. Costs of nodes that are not LOCAL anymore are discarded.
+		 *
+		 * @param graph Distributed graph
+		 */
+		void commitStep(fpmas::api::model::AgentGraph& graph);
+
+		/**
+		 * Smoothed cost of the specified node, in microseconds.
+		 */
+		double cost(fpmas::api::graph::DistributedId id) const;
+
+		/**
+		 * Sets the weight of each LOCAL node of the graph to its smoothed
+		 * cost, plus `communication_cost` for each of its outgoing DISTANT
+		 * edges, with a minimum of #min_weight.
+		 *
+		 * @param graph Distributed graph
+		 */
+		void updateWeights(fpmas::api::model::AgentGraph& graph) const;
+};
+
+/**
+ * A Behavior wrapper that measures the execution time of the wrapped behavior
+ * for each agent, and records it in an AutoWeights instance.
+ */
+class TimedBehavior : public fpmas::api::model::Behavior {
+	private:
+		const fpmas::api::model::Behavior& behavior;
+		AutoWeights& auto_weights;
+
+	public:
+		/**
+		 * TimedBehavior constructor.
+		 *
+		 * @param behavior Behavior to time
+		 * @param auto_weights AutoWeights instance in which costs are recorded
+		 */
+		TimedBehavior(
+				const fpmas::api::model::Behavior& behavior,
+				AutoWeights& auto_weights)
+			: behavior(behavior), auto_weights(auto_weights) {
+			}
+
+		/**
+		 * Executes the wrapped behavior on the agent and records its
+		 * execution time.
+		 */
+		void execute(fpmas::api::model::Agent* agent) const override;
+};
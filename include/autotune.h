@@ -0,0 +1,161 @@
+#pragma once
+
+#include "fpmas/api/scheduler/scheduler.h"
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file autotune.h
+ * Contains features used to automatically tune load balancing parameters.
+ */
+
+/**
+ * A probe run performed by the Autotune procedure.
+ */
+struct AutotuneTrial {
+	/**
+	 * Search phase: `LB_PERIOD` or `IMBALANCE_TOL`.
+	 */
+	std::string phase;
+	/**
+	 * Tested load balancing period.
+	 */
+	fpmas::api::scheduler::TimeStep lb_period;
+	/**
+	 * Tested Zoltan IMBALANCE_TOL parameter.
+	 */
+	float imbalance_tol;
+	/**
+	 * Count of simulated time steps.
+	 */
+	fpmas::api::scheduler::TimeStep steps;
+	/**
+	 * Measured run time, in seconds.
+	 */
+	double time;
+
+	/**
+	 * Average time of a time step, in seconds.
+	 */
+	double time_per_step() const {
+		return time / steps;
+	}
+};
+
+/**
+ * Searches the load balancing period and Zoltan IMBALANCE_TOL parameter that
+ * minimize the time required to run a given MetaModel.
+ *
+ * The objective function is the total run time of short probe runs, that
+ * includes load balancing (`BALANCE_TIME`, `DISTRIBUTE_TIME`),
+ * synchronization (`CELL_SYNC`) and compute times. Since probe runs might have
+ * different lengths, candidates are compared using the average time per step.
+ *
+ * The search is performed in two phases:
+ * 1. A successive halving among the candidate load balancing periods: all the
+ * candidates are run with an initial budget of time steps, the best half is
+ * kept, and the budget is doubled until a single candidate remains.
+ * 2. Optionally, a golden-section search of the IMBALANCE_TOL parameter in a
+ * given interval, with the best load balancing period.
+ */
+class Autotune {
+	public:
+		/**
+		 * Objective function, that runs a probe run with the specified load
+		 * balancing period, IMBALANCE_TOL and count of time steps, and returns
+		 * its run time in seconds.
+		 *
+		 * When the model is distributed, the returned time must be the same
+		 * on all processes (typically the maximum run time among processes),
+		 * so that all processes take the same decisions.
+		 */
+		typedef std::function<double(
+				fpmas::api::scheduler::TimeStep lb_period,
+				float imbalance_tol,
+				fpmas::api::scheduler::TimeStep steps)> Objective;
+
+	private:
+		Objective objective;
+		std::vector<AutotuneTrial> _trace;
+		fpmas::api::scheduler::TimeStep _best_lb_period = 1;
+		float _best_imbalance_tol;
+
+		AutotuneTrial& evaluate(
+				std::string phase,
+				fpmas::api::scheduler::TimeStep lb_period,
+				float imbalance_tol,
+				fpmas::api::scheduler::TimeStep steps);
+
+	public:
+		/**
+		 * Autotune constructor.
+		 *
+		 * @param objective Objective function to minimize
+		 */
+		Autotune(Objective objective);
+
+		/**
+		 * Successive halving among the specified load balancing periods.
+		 *
+		 * @param lb_periods Candidate load balancing periods
+		 * @param imbalance_tol IMBALANCE_TOL used in all probe runs
+		 * @param steps Initial count of time steps of probe runs. The
+		 * budget of each round is at least one step more than the largest
+		 * candidate period, so that all candidates perform at least one
+		 * load balancing after the initial one.
+		 * @param max_steps Maximum count of time steps of probe runs
+		 * @return best load balancing period
+		 */
+		fpmas::api::scheduler::TimeStep tuneLbPeriod(
+				std::vector<fpmas::api::scheduler::TimeStep> lb_periods,
+				float imbalance_tol,
+				fpmas::api::scheduler::TimeStep steps,
+				fpmas::api::scheduler::TimeStep max_steps);
+
+		/**
+		 * Golden-section search of the IMBALANCE_TOL parameter in
+		 * `[min, max]`, using the best load balancing period found so far.
+		 *
+		 * @param min Lower bound of the search interval
+		 * @param max Upper bound of the search interval
+		 * @param iterations Count of golden-section iterations. Each
+		 * iteration performs one probe run, except the first one that
+		 * performs two.
+		 * @param steps Count of time steps of probe runs
+		 * @return best IMBALANCE_TOL
+		 */
+		float tuneImbalanceTol(
+				float min, float max, unsigned int iterations,
+				fpmas::api::scheduler::TimeStep steps);
+
+		/**
+		 * Best load balancing period.
+		 */
+		fpmas::api::scheduler::TimeStep bestLbPeriod() const {
+			return _best_lb_period;
+		}
+
+		/**
+		 * Best IMBALANCE_TOL parameter.
+		 */
+		float bestImbalanceTol() const {
+			return _best_imbalance_tol;
+		}
+
+		/**
+		 * All the probe runs performed so far.
+		 */
+		const std::vector<AutotuneTrial>& trace() const {
+			return _trace;
+		}
+
+		/**
+		 * Writes the search trace as CSV, with the `PHASE`, `LB_PERIOD`,
+		 * `IMBALANCE_TOL`, `STEPS`, `TIME` and `TIME_PER_STEP` fields.
+		 *
+		 * @param output Output stream
+		 */
+		void writeTrace(std::ostream& output) const;
+};
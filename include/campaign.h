@@ -0,0 +1,133 @@
+#pragma once
+
+#include "fpmas/api/scheduler/scheduler.h"
+#include <string>
+#include <vector>
+
+/**
+ * @file campaign.h
+ * Contains features used to resume interrupted benchmark campaigns.
+ */
+
+/**
+ * Status of a run in a CampaignManifest.
+ */
+enum class RunStatus {
+	/**
+	 * The run was started, but its outputs are not complete.
+	 */
+	RUNNING,
+	/**
+	 * The run is complete, and its outputs were committed.
+	 */
+	COMPLETE
+};
+
+/**
+ * A run of a benchmark campaign.
+ */
+struct CampaignEntry {
+	/**
+	 * Name of the run, from which output file names are built.
+	 */
+	std::string name;
+	/**
+	 * Hash of the configuration of the run, as returned by config_hash().
+	 */
+	std::string config_hash;
+	/**
+	 * Seed of the run.
+	 */
+	unsigned long seed;
+	/**
+	 * Load balancing algorithm of the test case.
+	 */
+	std::string algorithm;
+	/**
+	 * Load balancing period of the test case.
+	 */
+	fpmas::api::scheduler::TimeStep lb_period;
+	/**
+	 * Status of the run.
+	 */
+	RunStatus status;
+};
+
+/**
+ * A CSV manifest of the runs of a benchmark campaign, with the
+ * `NAME,CONFIG_HASH,SEED,LB_ALGORITHM,LB_PERIOD,STATUS` fields.
+ *
+ * A run is marked as `RUNNING` before it starts, and as `COMPLETE` once its
+ * outputs are committed. A run can then be skipped when the campaign is
+ * resumed if it is `COMPLETE` with the same configuration hash and seed, so
+ * that runs interrupted or performed with another configuration are run
+ * again.
+ *
+ * The manifest file is rewritten under a temporary name and then renamed at
+ * each update, so that it is never left partially written.
+ */
+class CampaignManifest {
+	private:
+		std::string filename;
+		std::vector<CampaignEntry> entries;
+
+	public:
+		/**
+		 * CampaignManifest constructor.
+		 *
+		 * Entries of the existing manifest file are loaded, if any.
+		 *
+		 * @param filename Manifest file name
+		 */
+		CampaignManifest(std::string filename);
+
+		/**
+		 * Returns true iff the manifest contains a `COMPLETE` entry with the
+		 * same name, configuration hash and seed as the specified entry.
+		 */
+		bool complete(const CampaignEntry& entry) const;
+
+		/**
+		 * Returns true iff the manifest contains a `RUNNING` entry with the
+		 * same name, configuration hash and seed as the specified entry, i.e.
+		 * the run was interrupted and its checkpoint, if any, can be
+		 * restarted.
+		 */
+		bool running(const CampaignEntry& entry) const;
+
+		/**
+		 * Returns the `COMPLETE` entry with the specified configuration hash
+		 * and seed, or nullptr if there is no such entry.
+		 *
+		 * This can be used to find runs whose name is not known in
+		 * advance, such as autotuned runs.
+		 */
+		const CampaignEntry* completeRun(
+				const std::string& config_hash, unsigned long seed) const;
+
+		/**
+		 * Adds the specified entry to the manifest, or replaces the entry with
+		 * the same name, and rewrites the manifest file.
+		 */
+		void update(const CampaignEntry& entry);
+
+		/**
+		 * Entries of the manifest, in the order in which runs were started.
+		 */
+		const std::vector<CampaignEntry>& runs() const {
+			return entries;
+		}
+};
+
+/**
+ * Renames the `.part` CSV outputs of the specified run of the current process
+ * to their final names, i.e. `<name>.<rank>.csv.part` to `<name>.<rank>.csv`
+ * and `<name>.warmup.<rank>.csv.part`, if any, to `<name>.warmup.<rank>.csv`.
+ *
+ * Must be called once the MetaModel of the run is deleted, so that its outputs
+ * are closed.
+ *
+ * @param name Name of the run
+ * @param rank Rank of the current process
+ */
+void commit_outputs(std::string name, int rank);
@@ -2,6 +2,8 @@
 
 #include "config.h"
 #include "interactions.h"
+#include "workload.h"
+#include "cell_kernel.h"
 
 using namespace fpmas::model;
 
@@ -20,10 +22,99 @@ class MetaCell {
 		 * Default weight of CELL_SUCCESSOR edges.
 		 */
 		static float cell_edge_weight;
+		/**
+		 * Stencil kernel applied to cell data by cell interactions.
+		 *
+		 * Cell interactions that perform writes require the HARD_SYNC_MODE
+		 * sync_mode, since writes to DISTANT cells only modify their ghost
+		 * copy in other modes.
+		 */
+		static CellKernel cell_kernel;
+		/**
+		 * Count of hops within which cells interact with other cells,
+		 * following CELL_SUCCESSOR edges. If greater than 1, cells are
+		 * linked to all cells within this range on the CELL_INTERACTION
+		 * layer.
+		 *
+		 * @see link_interaction_range()
+		 */
+		static std::size_t interaction_range;
+		/**
+		 * Load balancing epoch, incremented after each load balancing so
+		 * that cached interaction neighbors are rebuilt after migrations.
+		 */
+		static std::size_t lb_epoch;
+		/**
+		 * Utility lost by a cell for each agent located on it. 0 disables
+		 * congestion.
+		 *
+		 * @see effectiveUtility()
+		 */
+		static float congestion;
+
+		/**
+		 * Layer of the neighbors with which cells interact:
+		 * CELL_INTERACTION if #interaction_range is greater than 1,
+		 * CELL_SUCCESSOR otherwise.
+		 */
+		static fpmas::api::graph::LayerId interactionLayer() {
+			return interaction_range > 1 ?
+				CELL_INTERACTION : fpmas::api::model::CELL_SUCCESSOR;
+		}
 
 	private:
 		float utility;
 		std::vector<char> data;
+		float workload = 0;
+		std::uint32_t agent_count = 0;
+		// Double buffered state computed by the cell_kernel, and state from
+		// which it was computed, so that writes performed since then can be
+		// merged into it. Not serialized nor assigned.
+		std::vector<char> next;
+		std::vector<char> next_base;
+		bool next_ready = false;
+		// Cached neighbors on the interactionLayer(), valid for the
+		// neighbors_epoch load balancing epoch, not serialized nor assigned
+		std::vector<fpmas::model::Neighbor<fpmas::api::model::Agent>>
+			interaction_neighbors;
+		std::size_t neighbors_epoch = -1;
+
+	protected:
+		/**
+		 * Returns the neighbors of the cell on the interactionLayer(). The
+		 * list is cached until the next load balancing, since edges between
+		 * cells never change but nodes might be migrated.
+		 *
+		 * @param build Function that builds the list of neighbors
+		 */
+		template<typename Build>
+		fpmas::model::Neighbors<fpmas::api::model::Agent> interactionNeighbors(
+				Build&& build) {
+			if(neighbors_epoch != lb_epoch) {
+				auto neighbors = build();
+				interaction_neighbors.assign(neighbors.begin(), neighbors.end());
+				neighbors_epoch = lb_epoch;
+			}
+			return fpmas::model::Neighbors<fpmas::api::model::Agent>(
+					interaction_neighbors);
+		}
+
+		/**
+		 * Executes the interaction with callbacks that apply the
+		 * #cell_kernel: data read from neighbors is accumulated, and the next
+		 * state of the cell is computed from it once the interaction is
+		 * complete, while data written to neighbors is modified in place.
+		 *
+		 * The next state only replaces the current state when
+		 * commitState() is called, so that all cells compute their next
+		 * state from the current state of their neighbors. Writes performed
+		 * on the cell after its next state is computed are merged into it
+		 * with cell_kernel_merge().
+		 *
+		 * @param interaction ReaderWriter interaction
+		 */
+		void kernelInteraction(
+				const std::function<void(const InteractionCallbacks&)>& interaction);
 
 	public:
 		// For edge migration optimization purpose only
@@ -58,12 +149,98 @@ class MetaCell {
 			: utility(utility), data(data) {
 			}
 
+		/**
+		 * Default MetaCell copy constructor.
+		 */
+		MetaCell(const MetaCell&) = default;
+		/**
+		 * Default MetaCell move constructor.
+		 */
+		MetaCell(MetaCell&&) = default;
+
+		/**
+		 * Assigns the serialized fields of the other cell to this cell.
+		 *
+		 * The next state computed by the #cell_kernel and the cached
+		 * interaction neighbors belong to the LOCAL instance of the cell, so
+		 * they are preserved. In HARD_SYNC_MODE, FPMAS assigns the data of a
+		 * LOCAL cell when a distant process releases it after a write: the
+		 * next state computed during the current time step must not be
+		 * dropped in this case.
+		 *
+		 * @param other Cell to copy
+		 */
+		MetaCell& operator=(const MetaCell& other);
+		/**
+		 * Moves the serialized fields of the other cell to this cell, with
+		 * the same semantics as the copy assignment.
+		 *
+		 * @param other Cell to move
+		 */
+		MetaCell& operator=(MetaCell&& other);
+
 		/**
 		 * Utility associated to this cell.
 		 */
 		float getUtility() const {
 			return utility;
 		}
+		/**
+		 * Sets the utility of this cell, typically once the utilities of all
+		 * cells have been computed from graph attractors.
+		 *
+		 * @param utility Utility of the cell
+		 */
+		void setUtility(float utility) {
+			this->utility = utility;
+		}
+		/**
+		 * Utility perceived by agents, i.e. the utility of the cell minus
+		 * `congestion` for each agent located on it, with a minimum of 0.
+		 *
+		 * The count of agents is the one of the last call to
+		 * updateAgentCount(), so that it can be read from DISTANT cells.
+		 */
+		float effectiveUtility() const {
+			if(congestion <= 0)
+				return utility;
+			return std::max(0.f, utility - congestion * agent_count);
+		}
+		/**
+		 * Count of agents located on the cell at the last call to
+		 * updateAgentCount().
+		 */
+		std::uint32_t getAgentCount() const {
+			return agent_count;
+		}
+		/**
+		 * Sets the count of agents located on the cell.
+		 */
+		void setAgentCount(std::uint32_t agent_count) {
+			this->agent_count = agent_count;
+		}
+		/**
+		 * Updates the count of agents located on the cell from its
+		 * incoming LOCATION edges.
+		 */
+		void updateAgentCount();
+		/**
+		 * Count of floating point operations performed by the
+		 * workload_kernel() at each cell interaction.
+		 *
+		 * @see ModelConfig::cell_workload
+		 */
+		float getWorkload() const {
+			return workload;
+		}
+		/**
+		 * Sets the workload of this cell.
+		 *
+		 * @param workload Count of floating point operations
+		 */
+		void setWorkload(float workload) {
+			this->workload = workload;
+		}
 		/**
 		 * Dummy data used to emulate different serialisation sizes.
 		 *
@@ -72,6 +249,31 @@ class MetaCell {
 		const std::vector<char>& getData() const {
 			return data;
 		}
+		/**
+		 * Resizes the dummy data of the cell.
+		 *
+		 * @param size New size of the data, in bytes
+		 * @see ModelConfig::cell_size_distribution
+		 */
+		void resizeData(std::size_t size) {
+			data.resize(size);
+		}
+		/**
+		 * Fills the data of the cell with random bytes, using
+		 * cell_kernel_init().
+		 *
+		 * @param seed Random seed
+		 */
+		void initState(std::uint64_t seed) {
+			cell_kernel_init(data, seed);
+		}
+		/**
+		 * Replaces the current state of the cell by the next state computed
+		 * by the #cell_kernel during the current time step, if any, merged
+		 * with the writes performed on the cell since the next state was
+		 * computed.
+		 */
+		void commitState();
 
 		/**
 		 * Sets the weight of outgoing CELL_SUCCESSOR edges to
@@ -108,6 +310,14 @@ class MetaCell {
 		 * Interactions::READ_ALL_WRITE_ALL behavior implementation.
 		 */
 		virtual void read_all_write_all_cell() = 0;
+		/**
+		 * Interactions::READ_K behavior implementation.
+		 */
+		virtual void read_k_cell() = 0;
+		/**
+		 * Interactions::WRITE_K behavior implementation.
+		 */
+		virtual void write_k_cell() = 0;
 
 		/**
 		 * Returns a pointer to the node containing the cell.
@@ -119,7 +329,8 @@ class MetaCell {
  * MetaCell JSON and ObjectPack serialization rules.
  *
  * The dummy MetaCell::getData() field is serialized, to produce a fake volume
- * of data.
+ * of data. The workload and the agent count of the cell are serialized so that
+ * they follow the cell when it migrates, and can be read from DISTANT cells.
  */
 template<typename CellType>
 struct CellSerialization {
@@ -127,14 +338,19 @@ struct CellSerialization {
 	 * Json serialization.
 	 */
 	static void to_json(nlohmann::json &j, const CellType *cell) {
-		j = {cell->getUtility(), cell->getData()};
+		j = {cell->getUtility(), cell->getData(), cell->getWorkload(),
+			cell->getAgentCount()};
 	}
 
 	/**
 	 * Json deserialization.
 	 */
 	static CellType* from_json(const nlohmann::json& j) {
-		return new CellType(j[0].get<float>(), j[1].get<std::vector<char>>());
+		CellType* cell = new CellType(
+				j[0].get<float>(), j[1].get<std::vector<char>>());
+		cell->setWorkload(j[2].get<float>());
+		cell->setAgentCount(j[3].get<std::uint32_t>());
+		return cell;
 	}
 
 	/**
@@ -142,7 +358,8 @@ struct CellSerialization {
 	 */
 	static std::size_t size(
 			const fpmas::io::datapack::ObjectPack &o, const CellType *cell) {
-		return o.size<float>() + o.size(cell->getData());
+		return 2 * o.size<float>() + o.size(cell->getData())
+			+ o.size<std::uint32_t>();
 	}
 
 	/**
@@ -152,6 +369,8 @@ struct CellSerialization {
 			fpmas::io::datapack::ObjectPack &o, const CellType *cell) {
 		o.put(cell->getUtility());
 		o.put(cell->getData());
+		o.put(cell->getWorkload());
+		o.put(cell->getAgentCount());
 	}
 
 	/**
@@ -160,14 +379,25 @@ struct CellSerialization {
 	static CellType* from_datapack(const fpmas::io::datapack::ObjectPack& o) {
 		float utility = o.get<float>();
 		std::vector<char> data = o.get<std::vector<char>>();
-		return new CellType(utility, data);
+		CellType* cell = new CellType(utility, data);
+		cell->setWorkload(o.get<float>());
+		cell->setAgentCount(o.get<std::uint32_t>());
+		return cell;
 	}
 };
 
 #define IMPLEM_CELL_INTERACTION(INTERACTION, CELL_TYPE)\
 	void INTERACTION##_cell() override {\
-		auto neighbors = this->outNeighbors<fpmas::api::model::Agent>(fpmas::api::model::CELL_SUCCESSOR);\
-		ReaderWriter::INTERACTION(neighbors);\
+		workload_kernel(this->getWorkload());\
+		auto neighbors = this->interactionNeighbors([this] () {\
+				return this->outNeighbors<fpmas::api::model::Agent>(MetaCell::interactionLayer());\
+				});\
+		if(MetaCell::cell_kernel == CellKernel::NONE)\
+			ReaderWriter::INTERACTION(neighbors);\
+		else\
+			this->kernelInteraction([&neighbors] (const InteractionCallbacks& callbacks) {\
+					ReaderWriter::INTERACTION(neighbors, callbacks);\
+					});\
 	}
 
 #define IMPLEM_CELL_INTERACTIONS(CELL_TYPE)\
@@ -176,7 +406,9 @@ struct CellSerialization {
 	IMPLEM_CELL_INTERACTION(write_all, CELL_TYPE)\
 	IMPLEM_CELL_INTERACTION(write_one, CELL_TYPE)\
 	IMPLEM_CELL_INTERACTION(read_all_write_one, CELL_TYPE)\
-	IMPLEM_CELL_INTERACTION(read_all_write_all, CELL_TYPE)
+	IMPLEM_CELL_INTERACTION(read_all_write_all, CELL_TYPE)\
+	IMPLEM_CELL_INTERACTION(read_k, CELL_TYPE)\
+	IMPLEM_CELL_INTERACTION(write_k, CELL_TYPE)
 
 /**
  * MetaCell extension of MetaGridModel.
@@ -267,8 +499,22 @@ class MetaGraphCell :
 
 /**
  * Generic UtilityFunction interface.
+ *
+ * The utility of a cell only depends on its distance to the center of the
+ * attractor: the euclidian distance in a grid environment, or the hop
+ * distance in a graph environment.
  */
 struct UtilityFunction {
+	/**
+	 * Returns an utility value associated to a cell at the specified distance
+	 * of the center of the given attractor.
+	 *
+	 * @param attractor Attractor from which the utility is computed
+	 * @param distance Distance from the center of the attractor, possibly
+	 * infinite if the center cannot be reached
+	 */
+	virtual float utility(Attractor attractor, float distance) const = 0;
+
 	/**
 	 * Returns an utility value associated to the specified point according to
 	 * the given attractor.
@@ -276,7 +522,16 @@ struct UtilityFunction {
 	 * @param attractor Attractor from which the utility is computed
 	 * @param point A discrete point of the grid environment
 	 */
-	virtual float utility(GridAttractor attractor, DiscretePoint point) const = 0;
+	float utility(GridAttractor attractor, DiscretePoint point) const;
+
+	/**
+	 * Distance from the center of the attractor beyond which the utility
+	 * function does not depend on the position of the attractor anymore.
+	 * Infinite by default.
+	 *
+	 * @param attractor Attractor
+	 */
+	virtual float support(Attractor attractor) const;
 
 	virtual ~UtilityFunction() {
 	}
@@ -288,7 +543,7 @@ struct UtilityFunction {
  * The utility is the same for all cells.
  */
 struct UniformUtility : public UtilityFunction {
-	float utility(GridAttractor attractor, DiscretePoint point) const override;
+	float utility(Attractor attractor, float distance) const override;
 };
 
 /**
@@ -298,7 +553,11 @@ struct UniformUtility : public UtilityFunction {
  * 0 until the radius of the attractor, and is set to 0 after the radius.
  */
 struct LinearUtility : public UtilityFunction {
-	float utility(GridAttractor attractor, DiscretePoint point) const override;
+	float utility(Attractor attractor, float distance) const override;
+	/**
+	 * The utility is 0 beyond the radius of the attractor.
+	 */
+	float support(Attractor attractor) const override;
 };
 
 /**
@@ -329,7 +588,7 @@ class InverseUtility : public UtilityFunction {
 		InverseUtility(float offset) : offset(offset) {
 		}
 
-		float utility(GridAttractor attractor, DiscretePoint point) const override;
+		float utility(Attractor attractor, float distance) const override;
 };
 
 /**
@@ -340,9 +599,18 @@ class InverseUtility : public UtilityFunction {
  * to 1 at the radius.
  */
 struct StepUtility : public UtilityFunction {
-	float utility(GridAttractor attractor, DiscretePoint point) const override;
+	float utility(Attractor attractor, float distance) const override;
 };
 
+/**
+ * Builds the UtilityFunction corresponding to the specified Utility:
+ * - Utility::UNIFORM: UniformUtility
+ * - Utility::LINEAR: LinearUtility
+ * - Utility::INVERSE: InverseUtility
+ * - Utility::STEP: StepUtility
+ */
+std::unique_ptr<UtilityFunction> make_utility_function(Utility utility);
+
 /**
  * Factory class that can be used by a GridBuilder to build MetaGridCells.
  *
@@ -402,3 +670,56 @@ class MetaGraphCellFactory {
 		MetaGraphCell* operator()();
 };
 
+/**
+ * Computes the utility of each local cell of a graph environment from the
+ * specified attractors.
+ *
+ * The center of each attractor is the cell with the index
+ * GraphAttractor::cell_index, cells being indexed in the order of their
+ * DistributedId. The hop distance from each cell to the center is computed
+ * with a level-synchronous distributed breadth-first search that follows
+ * CELL_SUCCESSOR edges backward, so that the distance of a cell is the
+ * minimum count of moves required to reach the center. Cells from which the
+ * center cannot be reached are considered at an infinite distance.
+ *
+ * The utility of each cell is then set to the sum of utilities generated by
+ * the utility_function for each attractor.
+ *
+ * Must be called on all processes, once the cell network is built and
+ * synchronized. Distant cells are updated at the next graph
+ * synchronization.
+ *
+ * @param cell_group Group containing all the cells of the model
+ * @param utility_function Utility function
+ * @param attractors List of attractors used to generate utilities
+ * @param comm Communicator on which the model is distributed
+ */
+void set_graph_utilities(
+		fpmas::api::model::AgentGroup& cell_group,
+		const UtilityFunction& utility_function,
+		const std::vector<GraphAttractor>& attractors,
+		fpmas::api::communication::MpiCommunicator& comm);
+
+/**
+ * Links each cell to all the cells within `range` hops on the
+ * CELL_INTERACTION layer, following CELL_SUCCESSOR edges.
+ *
+ * Cells are first linked to their CELL_SUCCESSORs. Then, at each round, each
+ * LOCAL cell relays its incoming CELL_INTERACTION edges: their sources are
+ * linked to its CELL_SUCCESSORs, so that only nodes already known by each
+ * process are linked. All the links of a round are collected before any of
+ * them is created, so each round extends neighborhoods by exactly one hop.
+ * Each cell then removes its duplicated edges and edges to itself. `range-1` rounds are performed, each requiring two graph
+ * synchronizations.
+ *
+ * Must be called on all processes, once the cell network is built and
+ * synchronized.
+ *
+ * @param model Model containing the cell network
+ * @param cell_group Group containing all the cells of the model
+ * @param range Interaction range, i.e. MetaCell::interaction_range
+ */
+void link_interaction_range(
+		fpmas::api::model::Model& model,
+		fpmas::api::model::AgentGroup& cell_group,
+		std::size_t range);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "config.h"
+#include <cstdint>
+
+/**
+ * @file cell_kernel.h
+ * Contains the stencil kernels applied to the data of cells by cell
+ * interactions.
+ *
+ * Cell data is processed as an array of bytes. All kernels are element-wise
+ * loops without branches over the payload, so that they are vectorized by the
+ * compiler. When payloads of different sizes are combined, only the common
+ * prefix is processed.
+ *
+ * @see ModelConfig::cell_interactions
+ * @see MetaCell::cell_kernel
+ */
+
+/**
+ * Adds the contribution of the data of a neighbor to `sums`, according to the
+ * kernel.
+ *
+ * - CellKernel::DIFFUSION: value of each byte
+ * - CellKernel::GAME_OF_LIFE: 1 if the byte is alive, i.e. if its lowest bit
+ *   is set, 0 otherwise
+ *
+ * @param kernel Cell kernel
+ * @param sums Sums of contributions of neighbors, one per byte of the cell
+ * data
+ * @param neighbor_data Data of the neighbor
+ */
+void cell_kernel_accumulate(
+		CellKernel kernel, std::vector<std::uint32_t>& sums,
+		const std::vector<char>& neighbor_data);
+
+/**
+ * Computes the next state of a cell from its current state and from the
+ * contributions of `count` neighbors.
+ *
+ * - CellKernel::DIFFUSION: each byte is set to the mean of its value and of
+ *   the values of neighbors.
+ * - CellKernel::GAME_OF_LIFE: each byte is alive at the next state if
+ *   exactly 3 neighbors are alive, or if it is alive and 2 neighbors are
+ *   alive.
+ *
+ * @param kernel Cell kernel
+ * @param data Current state of the cell
+ * @param sums Contributions of neighbors, computed by
+ * cell_kernel_accumulate()
+ * @param count Count of neighbors
+ * @param next Next state of the cell, resized to the size of `data`
+ */
+void cell_kernel_update(
+		CellKernel kernel, const std::vector<char>& data,
+		const std::vector<std::uint32_t>& sums, std::size_t count,
+		std::vector<char>& next);
+
+/**
+ * Modifies the data of a neighbor in place, from the data of the writing
+ * cell.
+ *
+ * - CellKernel::DIFFUSION: each byte of the neighbor is set to the mean of
+ *   its value and of the value of the writer.
+ * - CellKernel::GAME_OF_LIFE: live bytes of the writer are seeded in the
+ *   neighbor.
+ *
+ * @param kernel Cell kernel
+ * @param neighbor_data Data of the neighbor, modified in place
+ * @param data Data of the writing cell
+ */
+void cell_kernel_write(
+		CellKernel kernel, std::vector<char>& neighbor_data,
+		const std::vector<char>& data);
+
+/**
+ * Merges the writes performed on a cell during a time step into its next
+ * state, so that they are not lost when the next state replaces the current
+ * one.
+ *
+ * `base` is the state from which `next` was computed, and `data` the current
+ * state, that might have been modified by cell_kernel_write() since then.
+ *
+ * - CellKernel::DIFFUSION: the variation of each byte caused by writes is
+ *   added to the next state, clamped to [0, 255].
+ * - CellKernel::GAME_OF_LIFE: bytes seeded by writes are alive in the next
+ *   state.
+ *
+ * @param kernel Cell kernel
+ * @param base State from which the next state was computed
+ * @param data Current state of the cell
+ * @param next Next state of the cell, modified in place
+ */
+void cell_kernel_merge(
+		CellKernel kernel, const std::vector<char>& base,
+		const std::vector<char>& data, std::vector<char>& next);
+
+/**
+ * Fills the data of a cell with pseudo random bytes, generated from the
+ * specified seed, so that kernels start from a non trivial state.
+ *
+ * @param data Data of the cell
+ * @param seed Random seed
+ */
+void cell_kernel_init(std::vector<char>& data, std::uint64_t seed);
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "fpmas.h"
+#include "interactions.h"
+
+/**
+ * @file checkpoint.h
+ * Contains features used to checkpoint and restart MetaModel runs.
+ */
+
+/**
+ * MetaModel data saved in a checkpoint, in addition to the FPMAS model itself.
+ */
+struct CheckpointState {
+	/**
+	 * Date at which the checkpoint was performed.
+	 */
+	fpmas::scheduler::Date date;
+	/**
+	 * Size of the MetaModelCsvOutput file at the time of the checkpoint, in
+	 * bytes.
+	 */
+	std::size_t csv_offset;
+	/**
+	 * State of the #random_interactions generator.
+	 */
+	fpmas::random::DistributedGenerator<> random_interactions;
+	/**
+	 * State of the
+	 * [RandomNeighbors::rd](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1RandomNeighbors.html)
+	 * generator, used to shuffle neighbors and by MovePolicyFunctions.
+	 */
+	fpmas::random::DistributedGenerator<> random_neighbors;
+
+	/**
+	 * Date at which the simulation must be resumed, i.e. the time step
+	 * following #date.
+	 */
+	fpmas::scheduler::TimeStep restart_time_step() const;
+};
+
+/**
+ * Checkpoint of a MetaModel run.
+ *
+ * Each process writes its own part of the model to the
+ * `<name>.checkpoint.<rank>.bin` file, where `name` is the name of the
+ * MetaModel. Only the last checkpoint is kept.
+ *
+ * The CSV output of a restarted run is merged with the CSV output of the
+ * interrupted run, so that a single CSV file covers all the time steps of the
+ * run. The internal state of load balancing algorithms is not checkpointed:
+ * algorithms that keep a state between load balancing operations, such as
+ * STATIC_ZOLTAN_CELL_LB or Zoltan repartitioning, compute a new partition
+ * from scratch at the first load balancing of the restarted run, so measures
+ * following a restart might differ from the ones of an uninterrupted run.
+ */
+class Checkpoint {
+	private:
+		fpmas::api::communication::MpiCommunicator& comm;
+		std::string filename;
+		std::string csv_filename;
+
+		CheckpointState loadState() const;
+
+	public:
+		/**
+		 * Checkpoint constructor.
+		 *
+		 * @param name Name of the MetaModel
+		 * @param comm Communicator on which the model is distributed
+		 */
+		Checkpoint(
+				std::string name,
+				fpmas::api::communication::MpiCommunicator& comm);
+
+		/**
+		 * Returns true iff a checkpoint file is available on **all**
+		 * processes.
+		 *
+		 * Must be called on all processes.
+		 */
+		bool exists() const;
+
+		/**
+		 * Dumps the local part of the model and the specified state to the
+		 * checkpoint file, replacing any previous checkpoint.
+		 *
+		 * @param model Model to dump
+		 * @param state MetaModel state
+		 */
+		void dump(
+				const fpmas::api::model::Model& model,
+				const CheckpointState& state) const;
+
+		/**
+		 * Loads the local part of the model and the MetaModel state from the
+		 * checkpoint file.
+		 *
+		 * Groups of the model must already be built.
+		 *
+		 * @param model Model to load
+		 * @return MetaModel state
+		 */
+		CheckpointState load(fpmas::api::model::Model& model) const;
+
+		/**
+		 * Saves the CSV output of the interrupted run, up to the checkpoint,
+		 * to the `<name>.<rank>.csv.part.restart` file, so that it is not
+		 * truncated when the restarted MetaModel is built.
+		 *
+		 * If the interrupted run was itself restarted, its rows are appended
+		 * to the existing `.restart` file.
+		 */
+		void backupCsv() const;
+
+		/**
+		 * Merges the `.restart` file with the CSV output of the restarted
+		 * run.
+		 *
+		 * Must be called once the restarted MetaModel is deleted, so that its
+		 * CSV output file is closed.
+		 */
+		void mergeCsv() const;
+
+		/**
+		 * Removes the checkpoint file and the `.restart` CSV backup, if
+		 * any, typically once the run is complete or when the checkpoint
+		 * does not match the run.
+		 */
+		void clear() const;
+};
+
+namespace fpmas { namespace io { namespace datapack {
+	/**
+	 * CheckpointState ObjectPack serialization rules.
+	 */
+	template<>
+		struct Serializer<CheckpointState> {
+			/**
+			 * ObjectPack size.
+			 */
+			static std::size_t size(
+					const ObjectPack& pack, const CheckpointState& state);
+			/**
+			 * ObjectPack serialization.
+			 */
+			static void to_datapack(
+					ObjectPack& pack, const CheckpointState& state);
+			/**
+			 * ObjectPack deserialization.
+			 */
+			static CheckpointState from_datapack(const ObjectPack& pack);
+		};
+}}}
@@ -3,6 +3,7 @@
 #include "yaml-cpp/yaml.h"
 #include "fpmas/api/scheduler/scheduler.h"
 #include "fpmas/api/model/spatial/grid.h"
+#include "fpmas/random/random.h"
 #include "fpmas/utils/macros.h"
 
 /**
@@ -19,7 +20,8 @@ FPMAS_DEFINE_GROUPS(
 		HANDLE_NEW_CONTACTS_GROUP,
 		MOVE_GROUP,
 		UPDATE_CELL_EDGE_WEIGHTS_GROUP,
-		CELL_GROUP);
+		CELL_GROUP,
+		GOSSIP_GROUP);
 /**
  * MOVE_GROUP alias, since all SpatialAgents and only them are contained in the
  * MOVE_GROUP AgentGroup.
@@ -29,7 +31,7 @@ FPMAS_DEFINE_GROUPS(
 /**
  * Defines layer ids used internally by the MetaModel.
  */
-FPMAS_DEFINE_LAYERS(CONTACT, NEW_CONTACT);
+FPMAS_DEFINE_LAYERS(CONTACT, NEW_CONTACT, CELL_INTERACTION);
 
 /**
  * Environment type.
@@ -113,51 +115,152 @@ enum class MovePolicy {
 };
 
 /**
- * Load balancing algorithms.
+ * Distribution of the workload of agents or cells.
+ *
+ * @see Workload
  */
-enum class LbAlgorithm {
+enum class WorkloadDistribution {
 	/**
-	 * A load balancing algorithm that applies Zoltan, taking into account the
-	 * agent scheduling. Very costly and not efficient.
-	 *
-	 * @see [ScheduledLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1graph_1_1ScheduledLoadBalancing.html)
+	 * All instances have the same workload.
 	 */
-	SCHEDULED_LB,
+	CONSTANT,
 	/**
-	 * Raw Zoltan load balancing.
-	 *
-	 * @see [ZoltanLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1graph_1_1ZoltanLoadBalancing.html)
+	 * Workloads are uniformly drawn in `[0, 2*flops]`.
 	 */
-	ZOLTAN_LB,
+	UNIFORM,
 	/**
-	 * Grid based load balancing.
-	 *
-	 * @see [GridLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1GridLoadBalancing.html)
+	 * Workloads follow a Pareto distribution with a shape `alpha` and a mean
+	 * `flops`, so that a few instances are much more expensive than others.
+	 */
+	PARETO,
+	/**
+	 * Workloads are proportional to the utility of the cell, or of the
+	 * initial location of the agent, `flops` being the workload of a cell
+	 * with the mean utility.
+	 */
+	UTILITY
+};
+
+/**
+ * Configuration of the synthetic compute kernel executed by each agent or cell
+ * behavior.
+ *
+ * The workload of each instance is drawn once, when it is built, and is then
+ * serialized with the instance.
+ *
+ * @see workload_kernel()
+ */
+struct Workload {
+	/**
+	 * Distribution of workloads.
+	 */
+	WorkloadDistribution distribution = WorkloadDistribution::CONSTANT;
+	/**
+	 * Mean count of floating point operations performed at each behavior
+	 * execution. 0 disables the kernel.
 	 */
-	GRID_LB,
+	float flops = 0;
 	/**
-	 * Zoltan applied only to the cell network, and agent assigned to the same
-	 * process as their location.
+	 * Shape of the PARETO distribution, that must be greater than 1.
+	 */
+	float alpha = 2;
+};
+
+/**
+ * Stencil kernel applied to the data of cells by cell interactions.
+ *
+ * @see cell_kernel.h
+ */
+enum class CellKernel {
+	/**
+	 * Cell data is never modified.
+	 */
+	NONE,
+	/**
+	 * Each byte of cell data is a concentration, averaged with the
+	 * concentrations of neighbors.
+	 */
+	DIFFUSION,
+	/**
+	 * Each byte of cell data is a Game of Life cell, alive if its lowest bit
+	 * is set, evolving according to the state of neighbors.
+	 */
+	GAME_OF_LIFE
+};
+
+/**
+ * Distribution of the size of cells data.
+ *
+ * @see ModelConfig::cell_size
+ */
+enum class CellSizeDistribution {
+	/**
+	 * All cells have `cell_size` bytes of data.
+	 */
+	CONSTANT,
+	/**
+	 * Sizes are uniformly drawn in `[0, 2*cell_size]`.
+	 */
+	UNIFORM,
+	/**
+	 * Sizes follow a log-normal distribution of mean `cell_size` and shape
+	 * `cell_size_sigma`, so that a few cells carry much more data than
+	 * others.
+	 */
+	LOGNORMAL,
+	/**
+	 * Sizes are proportional to the utility of the cell, `cell_size` being the
+	 * size of a cell with the mean utility.
+	 */
+	UTILITY
+};
+
+/**
+ * An agent species, that defines the perception range, move policy, weight and
+ * contacts of agents of this species.
+ *
+ * Fields not specified in the `species` configuration default to the global
+ * agent configuration (`MetaAgentBase`, `agent_weight`).
+ */
+struct Species {
+	/**
+	 * Name of the species.
+	 */
+	std::string name;
+	/**
+	 * Relative share of agents of this species. Shares of all species are
+	 * normalized, the total count of agents being defined by
+	 * `occupation_rate` or `agents_per_process`.
+	 */
+	float fraction = 1;
+	/**
+	 * Perception and mobility range size.
 	 *
-	 * The Zoltan load balancing is applied to the cell network at each
-	 * iteration.
+	 * @see MetaAgentBase::range_size
+	 */
+	std::size_t range_size = 1;
+	/**
+	 * Move policy.
 	 *
-	 * @see [CellLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1CellLoadBalancing.html)
+	 * @see MetaAgentBase::move_policy
+	 */
+	MovePolicy move_policy = MovePolicy::RANDOM;
+	/**
+	 * Node weight of agents of this species.
 	 */
-	ZOLTAN_CELL_LB,
+	float weight = 1;
 	/**
-	 * Same as ZOLTAN_CELL_LB, but the Zoltan algorithm is only applied to the
-	 * cell network the first time the algorithm is applied.
+	 * Maximum number of contacts.
 	 *
-	 * @see [StaticCellLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1StaticCellLoadBalancing.html)
+	 * @see MetaAgentBase::max_contacts
 	 */
-	STATIC_ZOLTAN_CELL_LB,
+	std::size_t max_contacts = 0;
 	/**
-	 * Completely random load balancing. Not recommended.
+	 * Weight of edges to contacts.
 	 *
-	 * @see [RandomLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1graph_1_1RandomLoadBalancing.html)
+	 * @see MetaAgentBase::contact_weight
 	 */
-	RANDOM_LB
+	float contact_weight = 1;
 };
 
 /**
@@ -212,7 +315,21 @@ enum class Interactions {
 	 * Performs a _read_ on all neighbors, and then performs a _write_ on all
 	 * neighbors.
 	 */
-	READ_ALL_WRITE_ALL
+	READ_ALL_WRITE_ALL,
+	/**
+	 * With a probability `p`, performs a _read_ on `k` neighbors randomly
+	 * selected without replacement.
+	 *
+	 * @see ReaderWriter::read_k()
+	 */
+	READ_K,
+	/**
+	 * With a probability `p`, performs a _write_ on `k` neighbors randomly
+	 * selected without replacement.
+	 *
+	 * @see ReaderWriter::write_k()
+	 */
+	WRITE_K
 };
 
 /**
@@ -242,8 +359,7 @@ enum class SyncMode {
 };
 
 /**
- * Grid and graph attractor base used to compute cell utilities. Only
- * Environment::GRID is currently supported.
+ * Grid and graph attractor base used to compute cell utilities.
  */
 struct Attractor {
 	/**
@@ -255,12 +371,71 @@ struct Attractor {
 /**
  * GridAttractor extension: the center of the Attractor is defined as a discrete
  * point on the grid.
+ *
+ * The center might move over time, according to a velocity or to a list of
+ * waypoints, and the attractor might be periodically switched on and off. The
+ * state of the attractor at any time step is directly computed from its
+ * parameters, so that it does not need to be saved.
  */
 struct GridAttractor : public Attractor {
 	/**
-	 * Coordinates of the center of the attractor.
+	 * Coordinates of the center of the attractor at time step 0.
 	 */
 	fpmas::api::model::DiscretePoint center;
+	/**
+	 * Velocity of the center, in cells per time step. The center bounces on
+	 * the borders of the grid.
+	 */
+	float velocity_x = 0, velocity_y = 0;
+	/**
+	 * Points visited in order by the center, starting from #center, at
+	 * #speed. The center goes back to #center after the last waypoint, and
+	 * the path is then repeated. Ignored if #speed is 0.
+	 */
+	std::vector<fpmas::api::model::DiscretePoint> waypoints;
+	/**
+	 * Speed at which #waypoints are visited, in cells per time step.
+	 */
+	float speed = 0;
+	/**
+	 * If not 0, the attractor is active during `on_period` time steps, and
+	 * then inactive during `off_period` time steps, starting at time step 0.
+	 */
+	fpmas::api::scheduler::TimeStep on_period = 0, off_period = 0;
+
+	/**
+	 * Returns true iff the center or the activity of the attractor changes
+	 * over time.
+	 */
+	bool isDynamic() const;
+
+	/**
+	 * Returns true iff the attractor generates utilities at the specified
+	 * time step.
+	 */
+	bool isActive(fpmas::api::scheduler::TimeStep time_step) const;
+
+	/**
+	 * Returns the center of the attractor at the specified time step, rounded
+	 * to the closest cell of a `grid_width*grid_height` grid.
+	 */
+	fpmas::api::model::DiscretePoint centerAt(
+			fpmas::api::scheduler::TimeStep time_step,
+			std::size_t grid_width, std::size_t grid_height) const;
+};
+
+/**
+ * GraphAttractor extension: the center of the Attractor is a cell of the graph
+ * environment, and its radius is a hop distance.
+ */
+struct GraphAttractor : public Attractor {
+	/**
+	 * Global index of the center cell, in [0, num_cells), cells being indexed
+	 * in the order of their DistributedId.
+	 *
+	 * @see set_graph_utilities()
+	 */
+	std::size_t cell_index;
 };
 
 /**
@@ -271,13 +446,21 @@ struct GridAttractor : public Attractor {
  */
 struct TestCaseConfig {
 	/**
-	 * Load balancing algorithm to test.
+	 * Name of the load balancing algorithm to test.
+	 *
+	 * @see LoadBalancingRegistry
 	 */
-	LbAlgorithm algorithm;
+	std::string algorithm;
 	/**
 	 * Periods at which the load balancing algorithm should be tested.
 	 */
 	std::vector<fpmas::api::scheduler::TimeStep> lb_periods;
+	/**
+	 * Optional path to a shared library from which the algorithm is loaded.
+	 *
+	 * @see LoadBalancingRegistry::load()
+	 */
+	std::string plugin;
 };
 
 /**
@@ -308,6 +491,14 @@ struct GraphConfig {
 	 * global graph.
 	 */
 	std::size_t num_cells;
+	/**
+	 * Weak scaling mode: if not 0, the total count of cells is set to
+	 * `cells_per_process` times the count of processes, and `grid_width` and
+	 * `grid_height` or `num_cells` are not loaded from the configuration.
+	 *
+	 * @see applyWeakScaling()
+	 */
+	std::size_t cells_per_process = 0;
 	/**
 	 * For environments other than GRID, specifies the average output degree of
 	 * each cell in the cell network.
@@ -334,6 +525,14 @@ struct GraphConfig {
 	 * of utilities generated by each attractor.
 	 */
 	std::vector<GridAttractor> grid_attractors;
+	/**
+	 * For environments other than GRID, list of GraphAttractors. The utility
+	 * of each cell corresponds to the sum of utilities generated by each
+	 * attractor, according to the hop distance from the cell to the center of
+	 * the attractor. If empty, all cells have the same utility, as with
+	 * Utility::UNIFORM.
+	 */
+	std::vector<GraphAttractor> graph_attractors;
 	/**
 	 * The Zoltan IMBALANCE_TOL parameter.
 	 *
@@ -357,6 +556,20 @@ struct GraphConfig {
 	 * at the end of each model test case.
 	 */
 	bool dot_output = false;
+	/**
+	 * Directory in which environment snapshots are stored. If empty,
+	 * snapshots are disabled and the environment is always built from
+	 * scratch.
+	 *
+	 * @see EnvironmentSnapshot
+	 */
+	std::string environment_snapshot;
+	/**
+	 * Random seed used to build the model. This field is not loaded from the
+	 * YAML file, but specified by the executable, usually from the command
+	 * line.
+	 */
+	unsigned long seed = fpmas::random::default_seed;
 
 	/**
 	 * Loads an optional configuration field into the corresponding attribute.
@@ -425,8 +638,68 @@ struct GraphConfig {
 	 * @param config YAML configuration
 	 */
 	GraphConfig(YAML::Node config);
+
+	/**
+	 * Returns true iff the size of the environment depends on the count of
+	 * processes.
+	 */
+	bool weakScaling() const {
+		return cells_per_process > 0;
+	}
+
+	/**
+	 * If cells_per_process is specified, sets `grid_width` and `grid_height`
+	 * with near_square_grid(), or `num_cells`, according to the specified
+	 * count of processes. Does nothing otherwise.
+	 *
+	 * @param process_count Count of processes on which the model is
+	 * distributed
+	 */
+	void applyWeakScaling(int process_count);
+
+	/**
+	 * Checks constraints between parameters that can only be checked once
+	 * the count of cells is known, i.e. after applyWeakScaling(), and sets
+	 * `is_valid` to false if they are not satisfied.
+	 *
+	 * Currently, the cell index of each graph attractor must be lower than
+	 * `num_cells`.
+	 */
+	void validate();
+
+	/**
+	 * Loads the `species` field, and sets MetaAgentBase::species_table
+	 * accordingly. Must be called once global agent fields are loaded.
+	 *
+	 * @param config YAML `species` node, possibly undefined
+	 */
+	void loadSpecies(YAML::Node config);
 };
 
+/**
+ * Computes the dimensions of a near-square grid that contains approximately
+ * `cell_count` cells.
+ *
+ * If `cell_count` can be decomposed as `width*height` with `width <=
+ * 2*height`, the exact grid with the smallest difference between width and
+ * height is returned. Otherwise, `width` is set to `ceil(sqrt(cell_count))`
+ * and `height` to `ceil(cell_count/width)`, so that the grid contains at most
+ * `width-1` extra cells.
+ *
+ * @param cell_count Expected count of cells
+ * @return {width, height}, with `width >= height`
+ */
+std::pair<std::size_t, std::size_t> near_square_grid(std::size_t cell_count);
+
+/**
+ * Computes a 64 bits FNV-1a hash of the YAML serialization of the specified
+ * node, that is stable across runs and platforms.
+ *
+ * @param node YAML node to hash
+ * @return hexadecimal hash
+ */
+std::string config_hash(const YAML::Node& node);
+
 /**
  * General MetaModel configuration.
  */
@@ -436,10 +709,33 @@ struct ModelConfig : public GraphConfig {
 	 * count * occupation_rate`.
 	 */
 	float occupation_rate;
+	/**
+	 * Weak scaling mode: if not 0, `occupation_rate` is set so that the total
+	 * count of agents is `agents_per_process` times the count of processes,
+	 * and is not loaded from the configuration.
+	 *
+	 * @see applyWeakScaling()
+	 */
+	std::size_t agents_per_process = 0;
+	/**
+	 * Agent species. If no `species` field is specified, a single species is
+	 * built from the global agent configuration.
+	 *
+	 * Each agent is assigned a random species at initialization, according
+	 * to the species fractions, and only stores the index of its species.
+	 */
+	std::vector<Species> species;
 	/**
 	 * Number of time steps to simulate.
 	 */
 	fpmas::api::scheduler::TimeStep num_steps;
+	/**
+	 * Number of time steps, included in num_steps, executed before
+	 * measurements start.
+	 *
+	 * @see WarmupCsvOutput
+	 */
+	fpmas::api::scheduler::TimeStep warmup_steps = 0;
 	/**
 	 * Type of agent interactions.
 	 */
@@ -448,6 +744,10 @@ struct ModelConfig : public GraphConfig {
 	 * Interactions between cells within the cell network. Spatial agent
 	 * interactions is currently not supported, so this feature is more relevant
 	 * in a pure graph model, where occupation_rate=0.
+	 *
+	 * READ_K and WRITE_K are parameterized with a map such as
+	 * `cell_interactions: {READ_K: {k: 3, p: 0.2}}`, loaded into
+	 * ReaderWriter::k and ReaderWriter::p.
 	 */
 	Interactions cell_interactions = Interactions::NONE;
 	/**
@@ -456,20 +756,102 @@ struct ModelConfig : public GraphConfig {
 	 * useful to reflect the DistributedMoveAlgorithm cost within the graph.
 	 */
 	bool dynamic_cell_edge_weights = false;
+	/**
+	 * If true, the weight of each cell node is set to `cell_weight` plus the
+	 * sum of the weights of agents currently located in the cell before each
+	 * load balancing, so that cell based load balancing algorithms take
+	 * hotspots into account. The weight of an agent is the weight of its
+	 * species, or `agent_weight` without species. Ignored if auto_weights is
+	 * true.
+	 */
+	bool dynamic_cell_weights = false;
+	/**
+	 * If true, node weights are derived from the measured execution time of
+	 * agent and cell behaviors, and updated before each load balancing. Initial
+	 * weights (cell_weight, agent_weight...) are only used by the first load
+	 * balancing.
+	 *
+	 * @see AutoWeights
+	 */
+	bool auto_weights = false;
+	/**
+	 * Weight of the last time step in the exponential moving average of
+	 * measured costs, in ]0, 1]. 1 means that only the last time step is
+	 * taken into account.
+	 */
+	float auto_weights_smoothing = 0.5f;
+	/**
+	 * Cost added to the weight of a node for each of its outgoing edges
+	 * to a DISTANT node, in microseconds, so that agents with many distant
+	 * interactions are considered more expensive.
+	 */
+	float auto_weights_communication_cost = 0.f;
 	/**
 	 * Synchronization mode.
 	 */
 	SyncMode sync_mode = SyncMode::GHOST_MODE;
+	/**
+	 * Count of threads used by each process to execute cell behaviors,
+	 * including the main thread.
+	 *
+	 * Only READ_ALL cell interactions under GHOST_MODE or GLOBAL_GHOST_MODE
+	 * are executed in parallel, since other interactions and agent behaviors
+	 * modify the distributed graph or rely on shared random generators. Other
+	 * behaviors are always executed sequentially.
+	 *
+	 * @see ThreadPool
+	 */
+	unsigned int num_threads = 1;
 	/**
 	 * Size of cells data, in bytes. This is useful to evaluate the evolution of
 	 * the duration of read/write operations depending of the amount of data to
 	 * transfer for each cell.
 	 */
 	std::size_t cell_size = 0;
+	/**
+	 * Distribution of the size of cells data, `cell_size` being the mean
+	 * size. Sizes are drawn once, at initialization.
+	 */
+	CellSizeDistribution cell_size_distribution = CellSizeDistribution::CONSTANT;
+	/**
+	 * Shape of the LOGNORMAL cell size distribution, i.e. standard deviation
+	 * of the logarithm of sizes.
+	 */
+	float cell_size_sigma = 1.f;
 	/**
 	 * Agent weight.
 	 */
 	float agent_weight = 1.0f;
+	/**
+	 * Expected count of agents spawned by each cell at each time step, for a
+	 * cell with the mean utility of the environment. The count of agents
+	 * spawned by each cell follows a Poisson distribution with a rate
+	 * proportional to its utility. 0 disables spawns.
+	 */
+	float spawn_rate = 0;
+	/**
+	 * Count of time steps after which an agent is removed from the model,
+	 * counted from its birth date. 0 disables deaths.
+	 *
+	 * @see MetaAgentBase::birthDate()
+	 */
+	fpmas::api::scheduler::TimeStep lifespan = 0;
+	/**
+	 * Workload of agents, executed by the move behavior.
+	 *
+	 * If a workload is specified, the weight of each agent is set to
+	 * `agent_weight` scaled by the ratio between its workload and the mean
+	 * workload.
+	 */
+	Workload agent_workload;
+	/**
+	 * Workload of cells, executed by cell interactions.
+	 *
+	 * If a workload is specified, the weight of each cell is set to
+	 * `cell_weight` scaled by the ratio between its workload and the mean
+	 * workload.
+	 */
+	Workload cell_workload;
 	/**
 	 * If agent_interactions is CONTACTS, period at which new contacts are added
 	 * from the current perceptions of the agent.
@@ -484,6 +866,27 @@ struct ModelConfig : public GraphConfig {
 	 * @see MetaAgent::create_relations_from_contacts()
 	 */
 	fpmas::api::scheduler::TimeStep refresh_distant_contacts;
+	/**
+	 * Period at which a Checkpoint of the model is performed. Checkpoints are
+	 * disabled if the period is 0.
+	 */
+	fpmas::api::scheduler::TimeStep checkpoint_period = 0;
+	/**
+	 * Initial count of time steps of autotune probe runs.
+	 *
+	 * @see Autotune
+	 */
+	fpmas::api::scheduler::TimeStep autotune_steps = 10;
+	/**
+	 * `[min, max]` interval in which the Zoltan IMBALANCE_TOL parameter is
+	 * searched in autotune mode.
+	 */
+	std::vector<float> autotune_imbalance_tol = {1.01f, 1.5f};
+	/**
+	 * Count of golden-section iterations used to tune the Zoltan
+	 * IMBALANCE_TOL parameter in autotune mode.
+	 */
+	unsigned int autotune_iterations = 5;
 	/**
 	 * List of test cases for the current set up. A new model is built and
 	 * simulated for each case.
@@ -504,6 +907,23 @@ struct ModelConfig : public GraphConfig {
 	 * @param config YAML configuration
 	 */
 	ModelConfig(YAML::Node config);
+
+	/**
+	 * Returns true iff the size of the environment or the count of agents
+	 * depends on the count of processes.
+	 */
+	bool weakScaling() const {
+		return GraphConfig::weakScaling() || agents_per_process > 0;
+	}
+
+	/**
+	 * Applies GraphConfig::applyWeakScaling(), and sets `occupation_rate`
+	 * from agents_per_process if specified.
+	 *
+	 * @param process_count Count of processes on which the model is
+	 * distributed
+	 */
+	void applyWeakScaling(int process_count);
 };
 
 namespace YAML {
@@ -525,12 +945,6 @@ namespace YAML {
 			static bool decode(const Node& node, MovePolicy& rhs);
 		};
 
-	template<>
-		struct convert<LbAlgorithm> {
-			static Node encode(const LbAlgorithm& rhs);
-			static bool decode(const Node& node, LbAlgorithm& rhs);
-		};
-
 	template<>
 		struct convert<AgentInteractions> {
 			static Node encode(const AgentInteractions& rhs);
@@ -549,6 +963,36 @@ namespace YAML {
 			static bool decode(const Node& node, SyncMode& rhs);
 		};
 
+	template<>
+		struct convert<WorkloadDistribution> {
+			static Node encode(const WorkloadDistribution& rhs);
+			static bool decode(const Node& node, WorkloadDistribution& rhs);
+		};
+
+	template<>
+		struct convert<CellKernel> {
+			static Node encode(const CellKernel& rhs);
+			static bool decode(const Node& node, CellKernel& rhs);
+		};
+
+	template<>
+		struct convert<CellSizeDistribution> {
+			static Node encode(const CellSizeDistribution& rhs);
+			static bool decode(const Node& node, CellSizeDistribution& rhs);
+		};
+
+	template<>
+		struct convert<Workload> {
+			static Node encode(const Workload& rhs);
+			static bool decode(const Node& node, Workload& rhs);
+		};
+
+	template<>
+		struct convert<Species> {
+			static Node encode(const Species& rhs);
+			static bool decode(const Node& node, Species& rhs);
+		};
+
 	template<>
 		struct convert<Attractor> {
 			static Node encode(const Attractor& rhs);
@@ -561,6 +1005,12 @@ namespace YAML {
 			static bool decode(const Node& node, GridAttractor& rhs);
 		};
 
+	template<>
+		struct convert<GraphAttractor> {
+			static Node encode(const GraphAttractor& rhs);
+			static bool decode(const Node& node, GraphAttractor& rhs);
+		};
+
 	template<>
 		struct convert<TestCaseConfig> {
 			static Node encode(const TestCaseConfig& rhs);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @file ensemble.h
+ * Contains features used to run ensembles of MetaModels with different seeds
+ * and to aggregate their CSV outputs.
+ */
+
+/**
+ * Deterministically generates `n` seeds from the specified base seed.
+ *
+ * Seeds are generated with an `std::seed_seq`, as the `gen-seed` utility. If
+ * `n` is 1, the base seed is returned as is, so that a single seed ensemble
+ * is equivalent to a regular run.
+ *
+ * @param seed Base seed
+ * @param n Count of seeds to generate
+ * @return ensemble seeds
+ */
+std::vector<unsigned long> ensemble_seeds(unsigned long seed, std::size_t n);
+
+/**
+ * Statistics of a sample of values.
+ */
+struct SampleStatistics {
+	/**
+	 * Count of values taken into account, i.e. without rejected outliers.
+	 */
+	std::size_t count = 0;
+	/**
+	 * Sample mean.
+	 */
+	double mean = 0;
+	/**
+	 * Sample standard deviation (with Bessel's correction).
+	 */
+	double stddev = 0;
+	/**
+	 * Minimum value.
+	 */
+	double min = 0;
+	/**
+	 * Half width of the 95% confidence interval of the mean, computed from the
+	 * Student's t-distribution. The confidence interval is
+	 * `[mean - ci95, mean + ci95]`.
+	 */
+	double ci95 = 0;
+};
+
+/**
+ * Computes statistics of the specified sample.
+ *
+ * If `reject_outliers` is true, values outside of the Tukey fences
+ * `[Q1 - 1.5 IQR, Q3 + 1.5 IQR]` are ignored.
+ *
+ * @param values Sample values
+ * @param reject_outliers Enables outliers rejection
+ * @return sample statistics
+ */
+SampleStatistics sample_statistics(
+		std::vector<double> values, bool reject_outliers);
+
+/**
+ * Aggregates CSV files produced by the runs of an ensemble.
+ *
+ * All files must have the same columns, the first one being the time step.
+ * Rows are matched by index, and only the rows available in all files are
+ * aggregated. For each other column `C`, the `C_MEAN`, `C_STDDEV`, `C_MIN`
+ * and `C_CI95` columns are written to the output file.
+ *
+ * @param csv_files CSV files of each run of the ensemble
+ * @param output_file Output CSV file
+ * @param reject_outliers Enables outliers rejection
+ *
+ * @see sample_statistics()
+ */
+void aggregate_ensemble(
+		const std::vector<std::string>& csv_files,
+		const std::string& output_file,
+		bool reject_outliers);
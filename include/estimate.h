@@ -0,0 +1,141 @@
+#pragma once
+
+#include "metamodel.h"
+#include <ostream>
+
+/**
+ * @file estimate.h
+ * Contains features used to estimate the memory and communication costs of a
+ * MetaModel before running it.
+ */
+
+/**
+ * Per process costs of a MetaModel.
+ *
+ * Counts are measured on a small sample build, then extrapolated to the full
+ * configuration with extrapolate_costs().
+ */
+struct CostEstimate {
+	/**
+	 * Count of LOCAL cells.
+	 */
+	double local_cells = 0;
+	/**
+	 * Count of LOCAL agents.
+	 */
+	double local_agents = 0;
+	/**
+	 * Count of DISTANT cells, i.e. ghost copies of cells owned by other
+	 * processes.
+	 */
+	double ghost_cells = 0;
+	/**
+	 * Count of DISTANT agents.
+	 */
+	double ghost_agents = 0;
+	/**
+	 * Count of outgoing edges of LOCAL cells on MetaCell::interactionLayer().
+	 */
+	double cell_edges = 0;
+	/**
+	 * Count of outgoing edges of LOCAL cells on MetaCell::interactionLayer(),
+	 * which target is DISTANT.
+	 */
+	double distant_cell_edges = 0;
+	/**
+	 * Count of outgoing edges of LOCAL agents, including CONTACT edges.
+	 */
+	double agent_edges = 0;
+	/**
+	 * Count of outgoing edges of LOCAL agents, which target is DISTANT.
+	 */
+	double distant_agent_edges = 0;
+	/**
+	 * Average serialized size of a cell, in bytes.
+	 */
+	double cell_bytes = 0;
+	/**
+	 * Average serialized size of an agent, in bytes, including up to
+	 * `max_contacts` contacts.
+	 */
+	double agent_bytes = 0;
+	/**
+	 * Resident memory used by the model, in bytes.
+	 */
+	double memory_bytes = 0;
+	/**
+	 * Rough volume of data exchanged at each time step, in bytes, according
+	 * to `cell_interactions`, `sync_mode` and agent moves. Load balancing is
+	 * not included.
+	 */
+	double step_message_bytes = 0;
+};
+
+/**
+ * Returns the configuration of a small sample of the specified configuration,
+ * that contains at most `cells_per_process` cells per process.
+ *
+ * For GRID environments, the grid is scaled down preserving its aspect
+ * ratio. The agent occupation rate is unchanged. Outputs, checkpoints and
+ * snapshots are disabled, and `num_steps` is set to 1, so that the sample
+ * only performs the initial load balancing and one time step.
+ *
+ * @param config Full configuration
+ * @param process_count Count of processes
+ * @param cells_per_process Maximum count of cells per process in the sample
+ */
+ModelConfig sample_config(
+		const ModelConfig& config, int process_count,
+		std::size_t cells_per_process = 1000);
+
+/**
+ * Measures the LOCAL costs of the specified model.
+ *
+ * Only counts and serialized sizes are measured:
+ * CostEstimate::memory_bytes and CostEstimate::step_message_bytes are left to
+ * 0.
+ *
+ * @param model Initialized model
+ */
+CostEstimate measure_costs(BasicMetaModel& model);
+
+/**
+ * Extrapolates costs measured on a sample model to the full configuration.
+ *
+ * Node and edge counts are scaled by the ratio of cell counts, except ghost
+ * counts and distant edge counts in GRID environments, that are scaled by
+ * its square root since they only depend on the perimeter of each partition.
+ * Memory is scaled by the ratio of counts of nodes and edges. CONTACT edges
+ * are added assuming all agents have `max_contacts` contacts, and the
+ * per step message volume is finally computed from cell_interactions and
+ * sync_mode.
+ *
+ * @param sample Costs measured on the sample model
+ * @param sample_config Configuration of the sample model
+ * @param config Full configuration
+ * @param process_count Count of processes
+ */
+CostEstimate extrapolate_costs(
+		const CostEstimate& sample, const ModelConfig& sample_config,
+		const ModelConfig& config, int process_count);
+
+/**
+ * Writes the CSV header of write_estimate().
+ *
+ * @param output Output stream
+ */
+void write_estimate_header(std::ostream& output);
+
+/**
+ * Writes a CostEstimate as a CSV row.
+ *
+ * @param output Output stream
+ * @param estimate Estimate to write
+ */
+void write_estimate(std::ostream& output, const CostEstimate& estimate);
+
+/**
+ * Current resident memory of the process, in bytes, read from
+ * `/proc/self/statm`. Returns 0 if not available.
+ */
+std::size_t resident_memory();
@@ -1,7 +1,8 @@
 #pragma once
 
 #include "fpmas.h"
-#include "fpmas/utils/perf.h"
+#include "probe.h"
+#include "config.h"
 
 /**
  * @file interactions.h
@@ -14,9 +15,50 @@
  */
 extern fpmas::random::DistributedGenerator<> random_interactions;
 
+/**
+ * Operations performed on neighbors by ReaderWriter interactions, while they
+ * are locked. Empty callbacks are ignored.
+ */
+struct InteractionCallbacks {
+	/**
+	 * Called on each neighbor within its `ReadGuard`.
+	 */
+	std::function<void(const fpmas::api::model::Agent*)> read;
+	/**
+	 * Called on each neighbor within its `AcquireGuard`.
+	 */
+	std::function<void(fpmas::api::model::Agent*)> write;
+};
+
+/**
+ * Probes used by ReaderWriter interactions to measure read and write
+ * operations, depending on the state of the neighbor.
+ */
+struct InteractionProbes {
+	/**
+	 * Probe used for read operations on LOCAL neighbors.
+	 */
+	ConcurrentProbe& local_read;
+	/**
+	 * Probe used for write operations on LOCAL neighbors.
+	 */
+	ConcurrentProbe& local_write;
+	/**
+	 * Probe used for read operations on DISTANT neighbors.
+	 */
+	ConcurrentProbe& distant_read;
+	/**
+	 * Probe used for write operations on DISTANT neighbors.
+	 */
+	ConcurrentProbe& distant_write;
+};
+
 /**
  * Generic implementation of read/write behaviors defined is Interactions.
  *
+ * Probes are ConcurrentProbes, so that read_all() can be executed from
+ * several threads (see ModelConfig::num_threads).
+ *
  * The read `TargetAgent` type could normally be any MetaAgent or MetaCell type,
  * but currently only read/write operations among MetaGraphCells or
  * MetaGridCells are supported by the MetaModel.
@@ -27,74 +69,180 @@ struct ReaderWriter {
 	 * [ReadGuards](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1ReadGuard.html)
 	 * for read operations between two LOCAL agents.
 	 */
-	static fpmas::utils::perf::Probe local_read_probe;
+	static ConcurrentProbe local_read_probe;
 	/**
 	 * Probe used to measure the time passed in
 	 * [AcquireGuards](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1AcquireGuard.html)
 	 * for write operations between two LOCAL agents.
 	 */
-	static fpmas::utils::perf::Probe local_write_probe;
+	static ConcurrentProbe local_write_probe;
 	/**
 	 * Probe used to measure the time passed in
 	 * [ReadGuards](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1ReadGuard.html)
 	 * for read operations between two DISTANT agents.
 	 */
-	static fpmas::utils::perf::Probe distant_read_probe;
+	static ConcurrentProbe distant_read_probe;
 	/**
 	 * Probe used to measure the time passed in
 	 * [AcquireGuards](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1AcquireGuard.html)
 	 * for write operations between two DISTANT agents.
 	 */
-	static fpmas::utils::perf::Probe distant_write_probe;
+	static ConcurrentProbe distant_write_probe;
+	/**
+	 * Probes used for interactions between cells, i.e. #local_read_probe,
+	 * #local_write_probe, #distant_read_probe and #distant_write_probe.
+	 */
+	static const InteractionProbes cell_probes;
+
+	/**
+	 * Probe used for read operations between two LOCAL agents in contact.
+	 */
+	static ConcurrentProbe contact_local_read_probe;
+	/**
+	 * Probe used for write operations between two LOCAL agents in contact.
+	 */
+	static ConcurrentProbe contact_local_write_probe;
+	/**
+	 * Probe used for read operations from a LOCAL agent to a DISTANT
+	 * contact.
+	 */
+	static ConcurrentProbe contact_distant_read_probe;
+	/**
+	 * Probe used for write operations from a LOCAL agent to a DISTANT
+	 * contact.
+	 */
+	static ConcurrentProbe contact_distant_write_probe;
+	/**
+	 * Probes used for interactions between agents in contact.
+	 */
+	static const InteractionProbes contact_probes;
+
+	/**
+	 * Maximum count of neighbors selected by read_k() and write_k().
+	 */
+	static std::size_t k;
+	/**
+	 * Probability that read_k() and write_k() interact with neighbors at
+	 * each call.
+	 */
+	static float p;
 
 	/**
 	 * Applies a `ReadGuard` on all neighbors.
 	 *
 	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
 	 */
 	static void read_all(
-			const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors);
+			const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
 
 	/**
 	 * Applies an `AcquireGuard` on all neighbors.
 	 *
 	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
 	 */
 	static void write_all(
-			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors);
+			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
 
 	/**
 	 * Applies a `ReadGuard` on a randomly selected neighbor, using the
 	 * #random_interactions generator.
 	 *
 	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
 	 */
 	static void read_one(
-			const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors);
+			const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
 
 	/**
 	 * Applies an `AcquireGuard` on a randomly selected neighbor, using the
 	 * #random_interactions generator.
 	 *
 	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
 	 */
 	static void write_one(
-			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors);
+			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
+
+	/**
+	 * With a probability #p, applies a `ReadGuard` on #k neighbors randomly
+	 * selected without replacement, using the #random_interactions
+	 * generator. All neighbors are read if there are less than #k
+	 * neighbors.
+	 *
+	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
+	 */
+	static void read_k(
+			const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
+
+	/**
+	 * With a probability #p, applies an `AcquireGuard` on #k neighbors
+	 * randomly selected without replacement, using the
+	 * #random_interactions generator. All neighbors are written if there
+	 * are less than #k neighbors.
+	 *
+	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
+	 */
+	static void write_k(
+			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
 
 	/**
 	 * Applies read_all(), then write_all().
 	 *
 	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
 	 */
 	static void read_all_write_all(
-			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors);
+			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
 
 	/**
 	 * Applies read_all(), then write_one().
 	 *
 	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
 	 */
 	static void read_all_write_one(
-			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors);
-};
+			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
 
+	/**
+	 * Applies the ReaderWriter operation corresponding to the specified
+	 * Interactions. Does nothing with Interactions::NONE.
+	 *
+	 * @param interactions interactions scheme
+	 * @param neighbors list of neighbors to interact with 
+	 * @param callbacks operations performed on locked neighbors
+	 * @param probes probes measuring operations
+	 */
+	static void interact(
+			Interactions interactions,
+			fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+			const InteractionCallbacks& callbacks = {},
+			const InteractionProbes& probes = cell_probes);
+};
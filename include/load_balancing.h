@@ -0,0 +1,202 @@
+#pragma once
+
+#include "fpmas.h"
+#include "fpmas/model/spatial/cell_load_balancing.h"
+#include "config.h"
+#include <functional>
+#include <map>
+#include <memory>
+
+/**
+ * @file load_balancing.h
+ * Contains the registry of load balancing algorithms that can be used in
+ * test cases.
+ */
+
+/**
+ * Data available to build a load balancing algorithm for a test case.
+ */
+struct LoadBalancingContext {
+	/**
+	 * Model configuration.
+	 */
+	const ModelConfig& config;
+	/**
+	 * Load balancing period of the test case.
+	 */
+	fpmas::api::scheduler::TimeStep lb_period;
+	/**
+	 * Scheduler of the model.
+	 */
+	fpmas::api::scheduler::Scheduler& scheduler;
+	/**
+	 * Runtime of the model.
+	 */
+	fpmas::api::runtime::Runtime& runtime;
+	/**
+	 * Communicator on which the model is distributed.
+	 */
+	fpmas::api::communication::MpiCommunicator& comm;
+};
+
+/**
+ * A load balancing algorithm built for a test case.
+ *
+ * Implementations own all the objects required by the load balancing
+ * algorithm, such as the ZoltanLoadBalancing instance used by a
+ * CellLoadBalancing.
+ */
+class LoadBalancingAlgorithm {
+	public:
+		/**
+		 * Load balancing algorithm used by the MetaModel.
+		 */
+		virtual fpmas::api::model::LoadBalancing& loadBalancing() = 0;
+
+		virtual ~LoadBalancingAlgorithm() {
+		}
+};
+
+/**
+ * A function that builds a LoadBalancingAlgorithm from a
+ * LoadBalancingContext.
+ */
+typedef std::function<LoadBalancingAlgorithm*(const LoadBalancingContext&)>
+LoadBalancingFactory;
+
+/**
+ * Registry of load balancing algorithms, keyed by the name used in the
+ * `test_cases` field of the configuration file.
+ *
+ * The following built-in algorithms are always available:
+ * - `SCHEDULED_LB`: Zoltan, taking into account the agent scheduling. Very
+ *   costly and not efficient. See
+ *   [ScheduledLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1graph_1_1ScheduledLoadBalancing.html).
+ * - `ZOLTAN_LB`: raw Zoltan load balancing. See
+ *   [ZoltanLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1graph_1_1ZoltanLoadBalancing.html).
+ * - `GRID_LB`: grid based load balancing. See
+ *   [GridLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1GridLoadBalancing.html).
+ * - `ZOLTAN_CELL_LB`: Zoltan applied only to the cell network, agents being
+ *   assigned to the same process as their location. See
+ *   [CellLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1CellLoadBalancing.html).
+ * - `STATIC_ZOLTAN_CELL_LB`: same as `ZOLTAN_CELL_LB`, but the Zoltan
+ *   algorithm is only applied to the cell network the first time the
+ *   algorithm is applied. See
+ *   [StaticCellLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1StaticCellLoadBalancing.html).
+ * - `RANDOM_LB`: completely random load balancing. Not recommended. See
+ *   [RandomLoadBalancing](https://fpmas.github.io/FPMAS/classfpmas_1_1graph_1_1RandomLoadBalancing.html).
+ *
+ * Third-party algorithms can be registered with add(), or loaded from shared
+ * libraries with load(). In both cases, the algorithm is wrapped by the
+ * MetaModel in the same LoadBalancingProbe as built-in algorithms, so the
+ * same CSV output is produced.
+ */
+class LoadBalancingRegistry {
+	private:
+		struct Entry {
+			LoadBalancingFactory factory;
+			bool uses_imbalance_tol;
+		};
+		static std::map<std::string, Entry>& entries();
+
+	public:
+		/**
+		 * Registers a load balancing algorithm.
+		 *
+		 * @param name Name of the algorithm
+		 * @param factory Function used to build the algorithm
+		 * @param uses_imbalance_tol True iff the algorithm relies on the
+		 * `zoltan_imbalance_tol` parameter
+		 */
+		static void add(
+				std::string name, LoadBalancingFactory factory,
+				bool uses_imbalance_tol = false);
+
+		/**
+		 * Loads a load balancing algorithm from the specified shared library
+		 * with `dlopen`, and registers it with the specified name.
+		 *
+		 * The library must define its entry point with the
+		 * METAMODEL_LOAD_BALANCING_PLUGIN() macro. The algorithm is
+		 * considered to rely on the `zoltan_imbalance_tol` parameter only if
+		 * the library declares it with the
+		 * METAMODEL_LOAD_BALANCING_USES_IMBALANCE_TOL() macro. The library is
+		 * never unloaded.
+		 *
+		 * @param name Name of the algorithm
+		 * @param library_path Path to the shared library
+		 * @return true iff the library was successfully loaded
+		 */
+		static bool load(std::string name, std::string library_path);
+
+		/**
+		 * Returns true iff an algorithm is registered with the specified
+		 * name.
+		 */
+		static bool contains(std::string name);
+
+		/**
+		 * Returns true iff the specified algorithm relies on the
+		 * `zoltan_imbalance_tol` parameter.
+		 */
+		static bool usesImbalanceTol(std::string name);
+
+		/**
+		 * Builds the specified algorithm.
+		 *
+		 * @param name Name of a registered algorithm
+		 * @param context Test case context
+		 * @return dynamically allocated load balancing algorithm
+		 */
+		static std::unique_ptr<LoadBalancingAlgorithm> build(
+				std::string name, const LoadBalancingContext& context);
+};
+
+/**
+ * Name of the symbol exported by load balancing plugins.
+ */
+#define METAMODEL_LOAD_BALANCING_SYMBOL "metamodel_load_balancing"
+
+/**
+ * Defines the entry point of a load balancing shared library.
+ *
+ * The body of the function must return a dynamically allocated
+ * [fpmas::api::model::LoadBalancing](https://fpmas.github.io/FPMAS/namespacefpmas_1_1api_1_1model.html)
+ * implementation. It is owned by the LoadBalancingAlgorithm built by
+ * LoadBalancingRegistry::build(), and deleted with `delete` once the test
+ * case is run, so it must be allocated with `new`. The library itself is
+ * never unloaded (`dlclose` is never called), so objects and functions it
+ * defines remain valid until the end of the program. Example:
+ * ```cpp
+ * METAMODEL_LOAD_BALANCING_PLUGIN(context) {
+ * 	return new MyPartitioner(context.comm, context.config.zoltan_imbalance_tol);
+ * }
+ * ```
+ *
+ * @param CONTEXT Name of the `const LoadBalancingContext&` parameter
+ */
+#define METAMODEL_LOAD_BALANCING_PLUGIN(CONTEXT)\
+	extern "C" fpmas::api::model::LoadBalancing* metamodel_load_balancing(\
+			const LoadBalancingContext& CONTEXT)
+
+/**
+ * Name of the optional symbol exported by load balancing plugins that rely on
+ * the `zoltan_imbalance_tol` parameter.
+ */
+#define METAMODEL_LOAD_BALANCING_USES_IMBALANCE_TOL_SYMBOL\
+	"metamodel_load_balancing_uses_imbalance_tol"
+
+/**
+ * Optionally declares if a load balancing shared library relies on the
+ * `zoltan_imbalance_tol` parameter, so that it is tuned in `--autotune` mode.
+ * Plugins that do not use this macro are assumed not to rely on it. Example:
+ * ```cpp
+ * METAMODEL_LOAD_BALANCING_USES_IMBALANCE_TOL(true)
+ * ```
+ *
+ * @param VALUE True iff the algorithm relies on `zoltan_imbalance_tol`
+ */
+#define METAMODEL_LOAD_BALANCING_USES_IMBALANCE_TOL(VALUE)\
+	extern "C" bool metamodel_load_balancing_uses_imbalance_tol() {\
+		return VALUE;\
+	}
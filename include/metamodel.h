@@ -5,6 +5,11 @@
 #include "output.h"
 #include "dot.h"
 #include "probe.h"
+#include "snapshot.h"
+#include "checkpoint.h"
+#include "thread_pool.h"
+#include "auto_weights.h"
+#include <random>
 
 /**
  * @file metamodel.h
@@ -39,8 +44,18 @@ class BasicMetaModel {
 
 		/**
 		 * Initializes the Cell network and Spatial Agents.
+		 *
+		 * If the `environment_snapshot` field of the configuration is set,
+		 * the model is loaded from an existing EnvironmentSnapshot if
+		 * available. Else, the model is built and dumped to a new snapshot.
 		 */
 		virtual BasicMetaModel* init() = 0;
+		/**
+		 * Initializes the MetaModel from its last Checkpoint, instead of
+		 * init(). The next call to run() resumes the simulation from the time
+		 * step following the checkpoint.
+		 */
+		virtual BasicMetaModel* restart() = 0;
 		/**
 		 * Runs the MetaModel.
 		 */
@@ -88,6 +103,12 @@ class MetaModel : public BasicMetaModel {
 		Behavior<MetaCell> cell_read_all_write_all_cell_behavior {
 			&MetaCell::read_all_write_all_cell
 		};
+		Behavior<MetaCell> cell_read_k_cell_behavior {
+			&MetaCell::read_k_cell
+		};
+		Behavior<MetaCell> cell_write_k_cell_behavior {
+			&MetaCell::write_k_cell
+		};
 
 		// Agent behaviors
 		Behavior<AgentType> create_relations_from_neighborhood {
@@ -102,12 +123,65 @@ class MetaModel : public BasicMetaModel {
 		Behavior<AgentType> move_behavior {
 			&AgentType::move
 		};
+		Behavior<AgentType> gossip_behavior {
+			&AgentType::gossip
+		};
 
 		fpmas::scheduler::detail::LambdaTask sync_graph_task {
 				[this] () {this->model.graph().synchronize();}
 				};
 		fpmas::scheduler::Job sync_graph {{sync_graph_task}};
 
+		fpmas::scheduler::detail::LambdaTask parallel_cell_task {
+				[this] () {this->parallelReadAllCell();}
+				};
+		fpmas::scheduler::Job parallel_cell_job {{parallel_cell_task}};
+
+		fpmas::scheduler::detail::LambdaTask update_utilities_task {
+				[this] () {this->updateUtilities(
+						this->config, this->model.runtime().currentDate());}
+				};
+		fpmas::scheduler::Job update_utilities_job {{update_utilities_task}};
+
+		fpmas::scheduler::detail::LambdaTask update_population_task {
+				[this] () {this->updatePopulation();}
+				};
+		fpmas::scheduler::Job update_population_job {{update_population_task}};
+
+		fpmas::scheduler::detail::LambdaTask checkpoint_task {
+				[this] () {this->checkpoint();}
+				};
+		fpmas::scheduler::Job checkpoint_job {{checkpoint_task}};
+
+		fpmas::scheduler::detail::LambdaTask update_agent_counts_task {
+				[this] () {
+					for(auto cell : this->model.cellGroup().localAgents())
+						dynamic_cast<MetaCell*>(cell)->updateAgentCount();
+				}
+				};
+		fpmas::scheduler::Job update_agent_counts_job {{update_agent_counts_task}};
+
+		fpmas::scheduler::detail::LambdaTask lb_epoch_task {
+				[] () {MetaCell::lb_epoch++;}
+				};
+
+		fpmas::scheduler::detail::LambdaTask commit_cells_task {
+				[this] () {this->commitCells();}
+				};
+
+		fpmas::scheduler::detail::LambdaTask commit_infections_task {
+				[this] () {this->commitInfections();}
+				};
+
+		fpmas::scheduler::detail::LambdaTask commit_costs_task {
+				[this] () {this->auto_weights.commitStep(this->model.graph());}
+				};
+		fpmas::scheduler::Job commit_costs_job {{commit_costs_task}};
+
+		fpmas::scheduler::detail::LambdaTask update_weights_task {
+				[this] () {this->updateWeights();}
+				};
+
 	protected:
 		/**
 		 * Spatial model instance.
@@ -117,22 +191,87 @@ class MetaModel : public BasicMetaModel {
 	private:
 		std::string name;
 		fpmas::utils::perf::Monitor monitor;
+		fpmas::utils::perf::Monitor warmup_monitor;
 
 		fpmas::utils::perf::Probe lb_algorithm_probe {"LB_ALGORITHM"};
 		fpmas::utils::perf::Probe sync_probe {"SYNC"};
+		fpmas::utils::perf::Probe contact_sync_probe {"CONTACT_SYNC"};
 		fpmas::utils::perf::Probe graph_balance_probe {"GRAPH_BALANCE"};
 
 		GraphBalanceProbe graph_balance_probe_job;
 		SyncProbeTask sync_probe_task;
+		SyncProbeTask contact_sync_probe_task;
 
 		MetaModelCsvOutput csv_output;
+		// Only built if config.warmup_steps > 0
+		std::unique_ptr<WarmupCsvOutput> warmup_output;
 		CellsLocationOutput cells_location_output;
 		CellsUtilityOutput cells_utility_output;
 		AgentsOutput agents_output;
 		DotOutput dot_output;
 		ModelConfig config;
 
+		// Time step from which run() starts
+		fpmas::scheduler::TimeStep start_time_step = 0;
+
+		// Dumps the current state of the model to its Checkpoint
+		void checkpoint();
+
+		// Mean utility of all cells of the model
+		float meanUtility();
+
+		// Builds and schedules the WarmupCsvOutput, if config.warmup_steps
+		// > 0. Not called when a run is restarted after its warm-up phase,
+		// so that the warm-up output of the interrupted run is preserved.
+		void buildWarmupOutput();
+
+		// Reseeds random generators once the environment is initialized,
+		// so that the simulation uses the same random streams whether the
+		// environment is built or loaded from an EnvironmentSnapshot
+		void seedSimulation();
+
+		// Node weight of the species of the agent
+		float agentWeight(const MetaAgentBase* agent) const {
+			return agent->species() < config.species.size() ?
+				config.species[agent->species()].weight : config.agent_weight;
+		}
+
+		// Removes agents that reached their lifespan, spawns new agents on
+		// LOCAL cells according to their utility and initializes the
+		// location of new agents
+		void updatePopulation();
+
+		// Measured costs of LOCAL nodes, used if config.auto_weights is true
+		AutoWeights auto_weights;
+		std::vector<std::unique_ptr<TimedBehavior>> timed_behaviors;
+		// Updates node weights before a load balancing, according to
+		// config.auto_weights or config.dynamic_cell_weights
+		void updateWeights();
+		// Returns a TimedBehavior wrapping the behavior if
+		// config.auto_weights is true, the behavior itself otherwise
+		const fpmas::api::model::Behavior& timed(
+				const fpmas::api::model::Behavior& behavior);
+
+		// Commits the next state computed by the cell kernel of all LOCAL
+		// cells, and synchronizes the graph
+		void commitCells();
+
+		// Commits the infection state of all LOCAL agents computed by
+		// gossip(), and synchronizes the graph
+		void commitInfections();
+
+		// Threads used to execute cell behaviors in parallel
+		ThreadPool thread_pool;
+		// Executes the read_all_cell() behavior of all LOCAL cells using the
+		// thread pool
+		void parallelReadAllCell();
+
 	protected:
+		/**
+		 * Groups to which Spatial Agents are added, according to the model
+		 * configuration.
+		 */
+		fpmas::api::model::GroupList agentGroups();
 		/**
 		 * Method used to build the Cell network.
 		 *
@@ -146,6 +285,25 @@ class MetaModel : public BasicMetaModel {
 		 * @param config Model configuration
 		 */
 		virtual void buildAgents(const ModelConfig& config) = 0;
+		/**
+		 * Method called once the Cell network is available, either built or
+		 * loaded from an EnvironmentSnapshot, to synchronize cells specific
+		 * data that is not serialized. Does nothing by default.
+		 */
+		virtual void synchronizeCells() {
+		}
+		/**
+		 * Method called at each time step, from time step 1, if the
+		 * utilities of cells might change over time, to update utilities of
+		 * LOCAL cells. Does nothing by default.
+		 *
+		 * @param config Model configuration
+		 * @param time_step Current time step
+		 */
+		virtual void updateUtilities(
+				const ModelConfig& config,
+				fpmas::scheduler::TimeStep time_step) {
+		}
 
 	public:
 		/**
@@ -173,8 +331,10 @@ class MetaModel : public BasicMetaModel {
 
 		MetaModel<BaseModel, AgentType>* init() override;
 
+		MetaModel<BaseModel, AgentType>* restart() override;
+
 		void run() override {
-			model.runtime().run(config.num_steps);
+			model.runtime().run(start_time_step, config.num_steps);
 		}
 
 		std::string getName() const override {
@@ -219,48 +379,70 @@ MetaModel<BaseModel, AgentType>::MetaModel(
 			ReaderWriter::distant_read_probe,
 			ReaderWriter::distant_write_probe,
 			sync_probe,
+			ReaderWriter::contact_local_read_probe,
+			ReaderWriter::contact_local_write_probe,
+			ReaderWriter::contact_distant_read_probe,
+			ReaderWriter::contact_distant_write_probe,
+			contact_sync_probe,
 			monitor),
 	sync_probe_task(sync_probe, model.graph()),
+	contact_sync_probe_task(contact_sync_probe, model.graph()),
 	cells_location_output(*this, this->name, config.grid_width, config.grid_height),
 	cells_utility_output(*this, config.grid_width, config.grid_height),
 	agents_output(*this, config.grid_width, config.grid_height),
 	dot_output(*this, this->name + ".%t"),
-	config(config) {
+	config(config),
+	auto_weights(
+			config.auto_weights_smoothing,
+			config.auto_weights_communication_cost),
+	thread_pool(config.num_threads) {
 		switch(config.cell_interactions) {
 			case Interactions::READ_ALL:
 				model.buildGroup(
 						CELL_GROUP,
-						cell_read_all_cell_behavior
+						timed(cell_read_all_cell_behavior)
 						);
 				break;
 			case Interactions::WRITE_ALL:
 				model.buildGroup(
 						CELL_GROUP,
-						cell_write_all_cell_behavior
+						timed(cell_write_all_cell_behavior)
 						);
 				break;
 			case Interactions::READ_ONE:
 				model.buildGroup(
 						CELL_GROUP,
-						cell_read_one_cell_behavior
+						timed(cell_read_one_cell_behavior)
 						);
 				break;
 			case Interactions::WRITE_ONE:
 				model.buildGroup(
 						CELL_GROUP,
-						cell_write_one_cell_behavior
+						timed(cell_write_one_cell_behavior)
 						);
 				break;
 			case Interactions::READ_ALL_WRITE_ONE:
 				model.buildGroup(
 						CELL_GROUP,
-						cell_read_all_write_one_cell_behavior
+						timed(cell_read_all_write_one_cell_behavior)
 						);
 				break;
 			case Interactions::READ_ALL_WRITE_ALL:
 				model.buildGroup(
 						CELL_GROUP,
-						cell_read_all_write_all_cell_behavior
+						timed(cell_read_all_write_all_cell_behavior)
+						);
+				break;
+			case Interactions::READ_K:
+				model.buildGroup(
+						CELL_GROUP,
+						timed(cell_read_k_cell_behavior)
+						);
+				break;
+			case Interactions::WRITE_K:
+				model.buildGroup(
+						CELL_GROUP,
+						timed(cell_write_k_cell_behavior)
 						);
 				break;
 			default:
@@ -271,20 +453,39 @@ MetaModel<BaseModel, AgentType>::MetaModel(
 				break;
 		}
 		auto& create_relations_neighbors_group = model.buildGroup(
-				RELATIONS_FROM_NEIGHBORS_GROUP, create_relations_from_neighborhood
+				RELATIONS_FROM_NEIGHBORS_GROUP, timed(create_relations_from_neighborhood)
 				);
 		auto& create_relations_contacts_group = model.buildGroup(
-				RELATIONS_FROM_CONTACTS_GROUP, create_relations_from_contacts
+				RELATIONS_FROM_CONTACTS_GROUP, timed(create_relations_from_contacts)
 				);
 		auto& handle_new_contacts_group = model.buildGroup(
-				HANDLE_NEW_CONTACTS_GROUP, handle_new_contacts
+				HANDLE_NEW_CONTACTS_GROUP, timed(handle_new_contacts)
 				);
 		auto& move_group = model.buildMoveGroup(
-				MOVE_GROUP, move_behavior
+				MOVE_GROUP, timed(move_behavior)
+				);
+		auto& gossip_group = model.buildGroup(
+				GOSSIP_GROUP, timed(gossip_behavior)
 				);
 
 	
+		if(config.auto_weights || config.dynamic_cell_weights)
+			// Node weights are updated just before each load balancing
+			graph_balance_probe_job.job.setBeginTask(update_weights_task);
+		// Cached cell neighbors are invalidated by migrations
+		graph_balance_probe_job.job.setEndTask(lb_epoch_task);
 		scheduler.schedule(0, lb_period, graph_balance_probe_job.job);
+		if(config.environment == Environment::GRID
+				&& std::any_of(
+					config.grid_attractors.begin(), config.grid_attractors.end(),
+					[] (const GridAttractor& attractor) {
+					return attractor.isDynamic();
+					})) {
+			// Updated utilities are fetched by distant cells before agents
+			// act
+			update_utilities_job.setEndTask(sync_graph_task);
+			scheduler.schedule(1.19, 1, update_utilities_job);
+		}
 		if(config.occupation_rate > 0.0) {
 			if(config.agent_interactions == AgentInteractions::CONTACTS) {
 				scheduler.schedule(
@@ -299,21 +500,53 @@ MetaModel<BaseModel, AgentType>::MetaModel(
 						0.22, config.refresh_distant_contacts,
 						handle_new_contacts_group.jobs()
 						);
+				if(MetaAgentBase::contact_interactions != Interactions::NONE) {
+					// Infection states are committed with the
+					// synchronization that ends contact interactions
+					gossip_group.agentExecutionJob().setEndTask(
+							commit_infections_task);
+					scheduler.schedule(0.225, 1, gossip_group.jobs());
+				}
 			}
 			scheduler.schedule(0.23, 1, move_group.jobs());
+			if(config.spawn_rate > 0 || config.lifespan > 0)
+				scheduler.schedule(0.235, 1, update_population_job);
+			if(MetaCell::congestion > 0) {
+				// Agent counts are fetched by distant cells before the next
+				// moves
+				update_agent_counts_job.setEndTask(sync_graph_task);
+				scheduler.schedule(0.237, 1, update_agent_counts_job);
+			}
 		}
 		if(config.dynamic_cell_edge_weights) {
 			auto& update_cell_edge_weights_group = model.buildGroup(
 					UPDATE_CELL_EDGE_WEIGHTS_GROUP,
-					cell_update_edge_weights_behavior);
+					timed(cell_update_edge_weights_behavior));
 			scheduler.schedule(0.24, 1, update_cell_edge_weights_group.jobs());
 		}
 		
-		if(config.cell_interactions != Interactions::NONE) {
-			model.getGroup(CELL_GROUP).agentExecutionJob().setEndTask(sync_probe_task);
+		// Cell states computed by the cell kernel are committed with the
+		// synchronization that ends cell interactions
+		fpmas::api::scheduler::Task& cell_end_task
+			= MetaCell::cell_kernel == CellKernel::NONE ?
+			(fpmas::api::scheduler::Task&) sync_probe_task : commit_cells_task;
+		if(config.num_threads > 1
+				&& config.cell_interactions == Interactions::READ_ALL
+				&& config.sync_mode != SyncMode::HARD_SYNC_MODE) {
+			// In ghost modes, read operations only access local data, and
+			// can safely be performed concurrently
+			parallel_cell_job.setEndTask(cell_end_task);
+			scheduler.schedule(0.25, 1, parallel_cell_job);
+		} else if(config.cell_interactions != Interactions::NONE) {
+			model.getGroup(CELL_GROUP).agentExecutionJob().setEndTask(cell_end_task);
 			scheduler.schedule(0.25, 1, model.getGroup(CELL_GROUP).jobs());
 		}
-		scheduler.schedule(0.30, 1, csv_output.jobs());
+		if(config.auto_weights)
+			// Costs measured during the time step are committed once all
+			// behaviors are executed
+			scheduler.schedule(0.29, 1, commit_costs_job);
+		// CSV rows are only written from the steady phase
+		scheduler.schedule(config.warmup_steps + 0.30, 1, csv_output.jobs());
 
 		fpmas::scheduler::TimeStep last_lb_date
 			= ((config.num_steps-1) / lb_period) * lb_period;
@@ -341,25 +574,341 @@ MetaModel<BaseModel, AgentType>::MetaModel(
 		if(config.dot_output)
 			// Dot output
 			scheduler.schedule(last_lb_date + 0.04, dot_output.job());
+		if(config.checkpoint_period > 0)
+			// Checkpoint at the end of the last time step of each period
+			scheduler.schedule(
+					config.checkpoint_period - 1 + 0.90,
+					config.checkpoint_period, checkpoint_job);
 }
 
 template<typename BaseModel, typename AgentType>
 MetaModel<BaseModel, AgentType>* MetaModel<BaseModel, AgentType>::init() {
+	if(!config.environment_snapshot.empty()) {
+		EnvironmentSnapshot snapshot(config, model.getMpiCommunicator());
+		if(snapshot.exists()) {
+			// Nodes, edges, weights and partition are loaded from the
+			// snapshot
+			snapshot.load(model);
+			synchronizeCells();
+			model.graph().synchronize();
+			seedSimulation();
+			buildWarmupOutput();
+			return this;
+		}
+	}
 	buildCells(config);
 	model.graph().synchronize();
+	if(MetaCell::interaction_range > 1)
+		link_interaction_range(
+				model, model.cellGroup(), MetaCell::interaction_range);
 
 	buildAgents(config);
-	// Static node weights
-	for(auto cell : model.cellGroup().localAgents())
-		cell->node()->setWeight(config.cell_weight);
-	for(auto agent : model.getGroup(AGENT_GROUP).localAgents())
-		agent->node()->setWeight(config.agent_weight);
+	// Static workloads and node weights
+	float mean_utility = meanUtility();
+	for(auto cell : model.cellGroup().localAgents()) {
+		MetaCell* meta_cell = dynamic_cast<MetaCell*>(cell);
+		meta_cell->setWorkload(draw_workload(
+					config.cell_workload, meta_cell->getUtility(), mean_utility));
+		cell->node()->setWeight(workload_weight(
+					config.cell_weight, config.cell_workload,
+					meta_cell->getWorkload()));
+		if(config.cell_size_distribution != CellSizeDistribution::CONSTANT)
+			meta_cell->resizeData(draw_cell_size(
+						config.cell_size_distribution, config.cell_size,
+						config.cell_size_sigma,
+						meta_cell->getUtility(), mean_utility));
+		if(MetaCell::cell_kernel != CellKernel::NONE)
+			meta_cell->initState(fpmas::model::RandomNeighbors::rd());
+		meta_cell->updateAgentCount();
+	}
+	fpmas::random::UniformRealDistribution<float> draw_infected(0, 1);
+	fpmas::random::UniformIntDistribution<fpmas::api::scheduler::TimeStep>
+		draw_age(0, config.lifespan > 0 ? config.lifespan - 1 : 0);
+	for(auto agent : model.getGroup(AGENT_GROUP).localAgents()) {
+		AgentType* meta_agent = dynamic_cast<AgentType*>(agent);
+		// Agents are initially located on LOCAL cells
+		meta_agent->setWorkload(draw_workload(
+					config.agent_workload,
+					meta_agent->locationCell()->getUtility(), mean_utility));
+		agent->node()->setWeight(workload_weight(
+					agentWeight(meta_agent), config.agent_workload,
+					meta_agent->workload()));
+		if(MetaAgentBase::contact_interactions != Interactions::NONE) {
+			bool infected = draw_infected(fpmas::model::RandomNeighbors::rd)
+				< MetaAgentBase::initial_infected;
+			meta_agent->setInfected(infected, infected);
+		}
+		if(config.lifespan > 0)
+			// Initial agents are born uniformly over the lifespan preceding
+			// the first time step, so that they do not all die at once. The
+			// birth date wraps around, but the age of the agent is still
+			// `time_step - birthDate()` in unsigned arithmetic.
+			meta_agent->setBirthDate(
+					(fpmas::api::scheduler::TimeStep) 0
+					- draw_age(fpmas::model::RandomNeighbors::rd));
+	}
 
 	model.graph().synchronize();
 
+	if(!config.environment_snapshot.empty())
+		EnvironmentSnapshot(config, model.getMpiCommunicator()).dump(model);
+
+	seedSimulation();
+	buildWarmupOutput();
+	return this;
+}
+
+template<typename BaseModel, typename AgentType>
+MetaModel<BaseModel, AgentType>* MetaModel<BaseModel, AgentType>::restart() {
+	CheckpointState state
+		= Checkpoint(name, model.getMpiCommunicator()).load(model);
+	random_interactions = state.random_interactions;
+	fpmas::model::RandomNeighbors::rd = state.random_neighbors;
+	start_time_step = state.restart_time_step();
+	if(start_time_step < config.warmup_steps)
+		// Warm-up measures only cover time steps following the restart
+		buildWarmupOutput();
+
+	synchronizeCells();
+	model.graph().synchronize();
 	return this;
 }
 
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::buildWarmupOutput() {
+	if(config.warmup_steps == 0)
+		return;
+	warmup_output.reset(new WarmupCsvOutput(
+			*this,
+			config.warmup_steps,
+			lb_algorithm_probe,
+			graph_balance_probe,
+			ReaderWriter::local_read_probe,
+			ReaderWriter::local_write_probe,
+			ReaderWriter::distant_read_probe,
+			ReaderWriter::distant_write_probe,
+			sync_probe,
+			ReaderWriter::contact_local_read_probe,
+			ReaderWriter::contact_local_write_probe,
+			ReaderWriter::contact_distant_read_probe,
+			ReaderWriter::contact_distant_write_probe,
+			contact_sync_probe,
+			warmup_monitor));
+	// During warm-up, probes are committed to the warm-up monitor, and a
+	// single row is dumped at the end of the warm-up phase
+	model.scheduler().schedule(
+			0.30, config.warmup_steps, 1, warmup_output->commitJob());
+	model.scheduler().schedule(
+			config.warmup_steps - 1 + 0.31, warmup_output->job());
+}
+
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::seedSimulation() {
+	// Derived from the seed used to build the environment, so that the
+	// simulation does not replay the initialization streams
+	std::seed_seq seq({
+			(std::seed_seq::result_type) config.seed,
+			(std::seed_seq::result_type) (config.seed >> 32),
+			(std::seed_seq::result_type) 1
+			});
+	std::seed_seq::result_type seed;
+	seq.generate(&seed, &seed + 1);
+	fpmas::seed(seed);
+	random_interactions.seed(seed);
+}
+
+template<typename BaseModel, typename AgentType>
+float MetaModel<BaseModel, AgentType>::meanUtility() {
+	fpmas::communication::TypedMpi<double> double_mpi(
+			model.getMpiCommunicator());
+	double utility = 0;
+	double cell_count = 0;
+	for(auto cell : model.cellGroup().localAgents()) {
+		utility += dynamic_cast<MetaCell*>(cell)->getUtility();
+		cell_count++;
+	}
+	utility = fpmas::communication::all_reduce(
+			double_mpi, utility, std::plus<double>());
+	cell_count = fpmas::communication::all_reduce(
+			double_mpi, cell_count, std::plus<double>());
+	return cell_count > 0 ? utility / cell_count : 0;
+}
+
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::updatePopulation() {
+	fpmas::scheduler::TimeStep time_step = model.runtime().currentDate();
+	if(config.lifespan > 0) {
+		std::vector<fpmas::api::model::Agent*> dead_agents;
+		for(auto agent : model.getGroup(AGENT_GROUP).localAgents())
+			if(time_step - dynamic_cast<MetaAgentBase*>(agent)->birthDate()
+					>= config.lifespan)
+				dead_agents.push_back(agent);
+		for(auto agent : dead_agents) {
+			// The agent is removed from the graph once it is removed from
+			// all its groups
+			auto groups = agent->groups();
+			for(auto group : groups)
+				group->remove(agent);
+		}
+	}
+
+	fpmas::communication::TypedMpi<double> double_mpi(
+			model.getMpiCommunicator());
+	double spawned = 0;
+	if(config.spawn_rate > 0) {
+		std::vector<fpmas::api::model::Agent*> local_cells
+			= model.cellGroup().localAgents();
+		float mean_utility = meanUtility();
+		SpeciesAgentFactory<AgentType> agent_factory;
+
+		for(auto cell : local_cells) {
+			float utility = dynamic_cast<MetaCell*>(cell)->getUtility();
+			float rate = config.spawn_rate;
+			if(mean_utility > 0)
+				rate *= utility / mean_utility;
+			if(rate <= 0)
+				continue;
+			fpmas::random::PoissonDistribution<std::size_t> spawn_count(rate);
+			std::size_t count = spawn_count(fpmas::model::RandomNeighbors::rd);
+			for(std::size_t i = 0; i < count; i++) {
+				AgentType* agent = agent_factory.build();
+				agent->setBirthDate(time_step);
+				agent->setWorkload(draw_workload(
+							config.agent_workload, utility, mean_utility));
+				// A new DistributedId is allocated by the first group
+				for(fpmas::api::model::AgentGroup& group : agentGroups())
+					group.add(agent);
+				agent->node()->setWeight(workload_weight(
+							agentWeight(agent), config.agent_workload,
+							agent->workload()));
+				agent->initLocation(dynamic_cast<CellType*>(cell));
+			}
+			spawned += count;
+		}
+	}
+	model.graph().synchronize();
+	if(fpmas::communication::all_reduce(
+				double_mpi, spawned, std::plus<double>()) > 0)
+		// Builds the mobility field and perceptions of new agents
+		model.runtime().execute(model.distributedMoveAlgorithm().jobs());
+}
+
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::parallelReadAllCell() {
+	auto cells = model.getGroup(CELL_GROUP).localAgents();
+	if(config.auto_weights) {
+		// AutoWeights is not thread safe: durations are recorded once all
+		// threads are done
+		std::vector<AutoWeights::Clock::duration> durations(cells.size());
+		thread_pool.parallelFor(cells.size(), [&cells, &durations] (std::size_t i) {
+				auto start = AutoWeights::Clock::now();
+				dynamic_cast<MetaCell*>(cells[i])->read_all_cell();
+				durations[i] = AutoWeights::Clock::now() - start;
+				});
+		for(std::size_t i = 0; i < cells.size(); i++)
+			auto_weights.record(cells[i]->node()->getId(), durations[i]);
+	} else {
+		thread_pool.parallelFor(cells.size(), [&cells] (std::size_t i) {
+				dynamic_cast<MetaCell*>(cells[i])->read_all_cell();
+				});
+	}
+}
+
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::updateWeights() {
+	if(config.auto_weights) {
+		auto_weights.updateWeights(model.graph());
+		return;
+	}
+	// dynamic_cell_weights: the LOCATION edges of each cell are maintained by
+	// the graph as agents move in and out, so iterating over them is cheap.
+	// The species of DISTANT agents is available, since it is serialized.
+	for(auto cell : model.cellGroup().localAgents()) {
+		MetaCell* meta_cell = dynamic_cast<MetaCell*>(cell);
+		float agents_weight = 0;
+		for(auto edge : meta_cell->cellNode()
+				->getIncomingEdges(fpmas::api::model::LOCATION))
+			agents_weight += agentWeight(dynamic_cast<MetaAgentBase*>(
+						edge->getSourceNode()->data().get()));
+		cell->node()->setWeight(
+				workload_weight(
+					config.cell_weight, config.cell_workload,
+					meta_cell->getWorkload())
+				+ agents_weight);
+	}
+}
+
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::commitCells() {
+	auto cells = model.cellGroup().localAgents();
+	if(config.sync_mode == SyncMode::HARD_SYNC_MODE) {
+		// Distant processes might read the current state of LOCAL cells
+		// until all processes are synchronized
+		sync_probe_task.run();
+		for(auto cell : cells)
+			dynamic_cast<MetaCell*>(cell)->commitState();
+	} else {
+		// Reads only access ghost copies: next states are committed before
+		// ghosts are updated
+		for(auto cell : cells)
+			dynamic_cast<MetaCell*>(cell)->commitState();
+		sync_probe_task.run();
+	}
+}
+
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::commitInfections() {
+	auto agents = model.getGroup(GOSSIP_GROUP).localAgents();
+	fpmas::random::UniformRealDistribution<float> draw(0, 1);
+	if(config.sync_mode == SyncMode::HARD_SYNC_MODE) {
+		// Distant processes might read the current state of LOCAL agents
+		// until all processes are synchronized
+		contact_sync_probe_task.run();
+		for(auto agent : agents)
+			dynamic_cast<MetaAgentBase*>(agent)->commitInfection(
+					draw(random_interactions) < MetaAgentBase::recovery_rate);
+	} else {
+		// Reads only access ghost copies: next states are committed before
+		// ghosts are updated
+		for(auto agent : agents)
+			dynamic_cast<MetaAgentBase*>(agent)->commitInfection(
+					draw(random_interactions) < MetaAgentBase::recovery_rate);
+		contact_sync_probe_task.run();
+	}
+}
+
+template<typename BaseModel, typename AgentType>
+fpmas::api::model::GroupList MetaModel<BaseModel, AgentType>::agentGroups() {
+	fpmas::api::model::GroupList groups {
+		model.getGroup(RELATIONS_FROM_NEIGHBORS_GROUP),
+		model.getGroup(RELATIONS_FROM_CONTACTS_GROUP),
+		model.getGroup(HANDLE_NEW_CONTACTS_GROUP)
+	};
+	if(MetaAgentBase::contact_interactions != Interactions::NONE)
+		groups.push_back(model.getGroup(GOSSIP_GROUP));
+	groups.push_back(model.getGroup(MOVE_GROUP));
+	return groups;
+}
+
+template<typename BaseModel, typename AgentType>
+const fpmas::api::model::Behavior& MetaModel<BaseModel, AgentType>::timed(
+		const fpmas::api::model::Behavior& behavior) {
+	if(!config.auto_weights)
+		return behavior;
+	timed_behaviors.emplace_back(new TimedBehavior(behavior, auto_weights));
+	return *timed_behaviors.back();
+}
+
+template<typename BaseModel, typename AgentType>
+void MetaModel<BaseModel, AgentType>::checkpoint() {
+	CheckpointState state;
+	state.date = model.runtime().currentDate();
+	state.csv_offset = csv_output.offset();
+	state.random_interactions = random_interactions;
+	state.random_neighbors = fpmas::model::RandomNeighbors::rd;
+	Checkpoint(name, model.getMpiCommunicator()).dump(model, state);
+}
+
 /**
  * A generic MetaModel extension where Spatial Agents are moving on a Moore grid.
  */
@@ -380,8 +929,9 @@ class MetaGridModel :
 			 * - Utility::INVERSE: InverseUtility
 			 * - Utility::STEP: StepUtility
 			 *
-			 * GridAttractors are defined from `config.grid_attractors`. See
-			 * MetaGridCell factory for more detailed information.
+			 * GridAttractors are defined from `config.grid_attractors`, at
+			 * their position at time step 0. See MetaGridCell factory for
+			 * more detailed information.
 			 *
 			 * If config.json_output is true, a `grid.json` file describing
 			 * the utility of Cells is built.
@@ -399,30 +949,41 @@ class MetaGridModel :
 			 * @param config Model configuration
 			 */
 			void buildAgents(const ModelConfig& config) override;
+
+			/**
+			 * Updates the utility of LOCAL cells according to the state of
+			 * dynamic GridAttractors at the specified time step.
+			 *
+			 * Only cells within the union of the supports of attractors,
+			 * at the previous and current time steps, whose center or
+			 * activity changed are updated.
+			 *
+			 * @param config Model configuration
+			 * @param time_step Current time step
+			 */
+			void updateUtilities(
+					const ModelConfig& config,
+					fpmas::scheduler::TimeStep time_step) override;
 };
 
+/**
+ * Returns the GridAttractors of the specified configuration that are active at
+ * the specified time step, with their center at this time step.
+ */
+std::vector<GridAttractor> grid_attractors_at(
+		const ModelConfig& config, fpmas::scheduler::TimeStep time_step);
+
 template<template<typename> class SyncMode>
 void MetaGridModel<SyncMode>::buildCells(const ModelConfig& config) {
-	std::unique_ptr<UtilityFunction> utility_function;
-	switch(config.utility) {
-		case Utility::UNIFORM:
-			utility_function.reset(new UniformUtility);
-			break;
-		case Utility::LINEAR:
-			utility_function.reset(new LinearUtility);
-			break;
-		case Utility::INVERSE:
-			utility_function.reset(new InverseUtility);
-			break;
-		case Utility::STEP:
-			utility_function.reset(new StepUtility);
-			break;
-	}
+	std::unique_ptr<UtilityFunction> utility_function
+		= make_utility_function(config.utility);
 	MetaGridCellFactory cell_factory(
-			*utility_function, config.grid_attractors, config.cell_size);
+			*utility_function, grid_attractors_at(config, 0), config.cell_size);
 	MooreGrid<MetaGridCell>::Builder grid(
 			cell_factory, config.grid_width, config.grid_height);
 	fpmas::api::model::GroupList cell_groups;
+	if(config.dynamic_cell_edge_weights)
+		cell_groups.push_back(this->model.getGroup(UPDATE_CELL_EDGE_WEIGHTS_GROUP));
 	if(config.cell_interactions != Interactions::NONE)
 		cell_groups.push_back(this->model.getGroup(CELL_GROUP));
 	auto local_cells = grid.build(this->model, cell_groups);
@@ -431,6 +992,56 @@ void MetaGridModel<SyncMode>::buildCells(const ModelConfig& config) {
 			.dump();
 }
 
+template<template<typename> class SyncMode>
+void MetaGridModel<SyncMode>::updateUtilities(
+		const ModelConfig& config, fpmas::scheduler::TimeStep time_step) {
+	std::unique_ptr<UtilityFunction> utility_function
+		= make_utility_function(config.utility);
+	// Regions in which utilities changed, as (center, support) pairs
+	std::vector<std::pair<DiscretePoint, float>> changed_regions;
+	for(auto& attractor : config.grid_attractors) {
+		if(!attractor.isDynamic())
+			continue;
+		bool previous_active = attractor.isActive(time_step-1);
+		bool active = attractor.isActive(time_step);
+		DiscretePoint previous_center = attractor.centerAt(
+				time_step-1, config.grid_width, config.grid_height);
+		DiscretePoint center = attractor.centerAt(
+				time_step, config.grid_width, config.grid_height);
+		if(previous_active == active
+				&& (!active || previous_center == center))
+			continue;
+		float support = utility_function->support(attractor);
+		if(previous_active)
+			changed_regions.push_back({previous_center, support});
+		if(active)
+			changed_regions.push_back({center, support});
+	}
+	if(changed_regions.empty())
+		return;
+
+	std::vector<GridAttractor> attractors
+		= grid_attractors_at(config, time_step);
+	for(auto cell : this->cellGroup().localAgents()) {
+		MetaGridCell* grid_cell = dynamic_cast<MetaGridCell*>(cell);
+		bool changed = false;
+		for(auto& region : changed_regions)
+			if(fpmas::api::model::euclidian_distance(
+						region.first, grid_cell->location()) <= region.second) {
+				changed = true;
+				break;
+			}
+		if(changed) {
+			// The utility is fully recomputed to prevent error accumulation
+			float utility = 0;
+			for(auto& attractor : attractors)
+				utility += utility_function->utility(
+						attractor, grid_cell->location());
+			grid_cell->setUtility(utility);
+		}
+	}
+}
+
 template<template<typename> class SyncMode>
 void MetaGridModel<SyncMode>::buildAgents(const ModelConfig& config) {
 	fpmas::model::UniformGridAgentMapping mapping(
@@ -438,17 +1049,10 @@ void MetaGridModel<SyncMode>::buildAgents(const ModelConfig& config) {
 			config.grid_width * config.grid_height * config.occupation_rate
 			);
 	fpmas::model::GridAgentBuilder<MetaGridCell> agent_builder;
-	fpmas::model::DefaultSpatialAgentFactory<MetaGridAgent> agent_factory;
+	SpeciesAgentFactory<MetaGridAgent> agent_factory;
 
 	agent_builder.build(
-			this->model,
-			{
-			this->model.getGroup(RELATIONS_FROM_NEIGHBORS_GROUP),
-			this->model.getGroup(RELATIONS_FROM_CONTACTS_GROUP),
-			this->model.getGroup(HANDLE_NEW_CONTACTS_GROUP),
-			this->model.getGroup(MOVE_GROUP)
-			},
-			agent_factory, mapping);
+			this->model, this->agentGroups(), agent_factory, mapping);
 }
 
 /**
@@ -476,6 +1080,11 @@ class MetaGraphModel :
 			 * builder to determine the proportion of edges to relink in the
 			 * Small-World build process.
 			 *
+			 * If `config.utility` is not Utility::UNIFORM and
+			 * `config.graph_attractors` is not empty, the utility of each
+			 * cell is computed from `config.graph_attractors` with
+			 * set_graph_utilities(). Otherwise, all cells have a utility of 1.
+			 *
 			 * @param config Model configuration
 			 */
 			void buildCells(const ModelConfig& config) override;
@@ -490,6 +1099,12 @@ class MetaGraphModel :
 			 * @param config Model configuration
 			 */
 			void buildAgents(const ModelConfig& config) override;
+
+			/**
+			 * Synchronizes the successors of cells required by the
+			 * GraphRange.
+			 */
+			void synchronizeCells() override;
 	};
 
 template<template<typename> class SyncMode>
@@ -524,6 +1139,15 @@ void MetaGraphModel<SyncMode>::buildCells(const ModelConfig& config) {
 
 	delete builder;
 
+	synchronizeCells();
+	if(config.utility != Utility::UNIFORM && !config.graph_attractors.empty())
+		set_graph_utilities(
+				this->cellGroup(), *make_utility_function(config.utility),
+				config.graph_attractors, this->model.getMpiCommunicator());
+}
+
+template<template<typename> class SyncMode>
+void MetaGraphModel<SyncMode>::synchronizeCells() {
 	GraphRange<MetaGraphCell>::synchronize(this->model);
 }
 
@@ -535,16 +1159,9 @@ void MetaGraphModel<SyncMode>::buildAgents(const ModelConfig& config) {
 			config.num_cells * config.occupation_rate
 			);
 	fpmas::model::SpatialAgentBuilder<MetaGraphCell> agent_builder;
-	fpmas::model::DefaultSpatialAgentFactory<MetaGraphAgent> agent_factory;
+	SpeciesAgentFactory<MetaGraphAgent> agent_factory;
 	agent_builder.build(
-			this->model,
-			{
-			this->model.getGroup(RELATIONS_FROM_NEIGHBORS_GROUP),
-			this->model.getGroup(RELATIONS_FROM_CONTACTS_GROUP),
-			this->model.getGroup(HANDLE_NEW_CONTACTS_GROUP),
-			this->model.getGroup(MOVE_GROUP)
-			},
-			agent_factory, mapping);
+			this->model, this->agentGroups(), agent_factory, mapping);
 }
 
 /**
@@ -47,6 +47,22 @@ class BasicMetaModel;
  *   DISTANT cell.
  * - `CELL_SYNC`: total time spent synchronizing read/write operations between
  *   cells.
+ * - `POPULATION`: count of LOCAL agents, that might change over time if
+ *   agents are spawned or removed (see ModelConfig::spawn_rate and
+ *   ModelConfig::lifespan)
+ * - `CELL_BYTES`: total size of the data of LOCAL cells, in bytes (see
+ *   ModelConfig::cell_size_distribution)
+ * - `LOCAL_CONTACT_READ_TIME`, `LOCAL_CONTACT_READ_COUNT`,
+ *   `LOCAL_CONTACT_WRITE_TIME`, `LOCAL_CONTACT_WRITE_COUNT`: total time spent
+ *   in and count of read/write operations between two LOCAL agents in
+ *   contact (see MetaAgentBase::contact_interactions)
+ * - `DISTANT_CONTACT_READ_TIME`, `DISTANT_CONTACT_READ_COUNT`,
+ *   `DISTANT_CONTACT_WRITE_TIME`, `DISTANT_CONTACT_WRITE_COUNT`: total time
+ *   spent in and count of read/write operations from a LOCAL agent to a
+ *   DISTANT contact
+ * - `CONTACT_SYNC`: total time spent synchronizing read/write operations
+ *   between agents in contact
+ * - `INFECTED`: count of LOCAL infected agents
  */
 class MetaModelCsvOutput :
 	public fpmas::io::FileOutput,
@@ -67,7 +83,19 @@ class MetaModelCsvOutput :
 		unsigned int, // DISTANT Cell->Cell read count
 		unsigned int, // DISTANT Cell->Cell write time
 		unsigned int, // DISTANT Cell->Cell write count
-		unsigned int // Sync time
+		unsigned int, // Sync time
+		std::size_t, // Population
+		std::size_t, // Cell bytes
+		unsigned int, // LOCAL Agent->Agent read time
+		unsigned int, // LOCAL Agent->Agent read count
+		unsigned int, // LOCAL Agent->Agent write time
+		unsigned int, // LOCAL Agent->Agent write count
+		unsigned int, // DISTANT Agent->Agent read time
+		unsigned int, // DISTANT Agent->Agent read count
+		unsigned int, // DISTANT Agent->Agent write time
+		unsigned int, // DISTANT Agent->Agent write count
+		unsigned int, // Contact sync time
+		std::size_t // Infected agents
 	> {
 		private:
 			fpmas::scheduler::detail::LambdaTask commit_probes_task;
@@ -81,8 +109,9 @@ class MetaModelCsvOutput :
 			 * MetaModelCsvOutput constructor.
 			 *
 			 * The name of the output CSV file is set as
-			 * "[model name].\%r.csv" where \%r is the rank of the current
-			 * process.
+			 * "[model name].\%r.csv.part" where \%r is the rank of the current
+			 * process. The file is renamed to "[model name].\%r.csv" by
+			 * commit_outputs() once the run is complete.
 			 *
 			 * @param meta_model Model from which data is gathered
 			 * @param balance_probe `BALANCE_TIME` probe
@@ -92,6 +121,15 @@ class MetaModelCsvOutput :
 			 * @param distant_read_probe `DISTANT_CELL_[READ/COUNT]_TIME` probe
 			 * @param distant_write_probe `DISTANT_CELL_[WRITE/COUNT]_TIME` probe
 			 * @param sync_probe `CELL_SYNC` probe
+			 * @param contact_local_read_probe
+			 * `LOCAL_CONTACT_[READ/COUNT]_TIME` probe
+			 * @param contact_local_write_probe
+			 * `LOCAL_CONTACT_[WRITE/COUNT]_TIME` probe
+			 * @param contact_distant_read_probe
+			 * `DISTANT_CONTACT_[READ/COUNT]_TIME` probe
+			 * @param contact_distant_write_probe
+			 * `DISTANT_CONTACT_[WRITE/COUNT]_TIME` probe
+			 * @param contact_sync_probe `CONTACT_SYNC` probe
 			 * @param monitor Monitor used to manage probes
 			 */
 			MetaModelCsvOutput(
@@ -103,6 +141,11 @@ class MetaModelCsvOutput :
 					fpmas::api::utils::perf::Probe& distant_read_probe,
 					fpmas::api::utils::perf::Probe& distant_write_probe,
 					fpmas::api::utils::perf::Probe& sync_probe,
+					fpmas::api::utils::perf::Probe& contact_local_read_probe,
+					fpmas::api::utils::perf::Probe& contact_local_write_probe,
+					fpmas::api::utils::perf::Probe& contact_distant_read_probe,
+					fpmas::api::utils::perf::Probe& contact_distant_write_probe,
+					fpmas::api::utils::perf::Probe& contact_sync_probe,
 					fpmas::api::utils::perf::Monitor& monitor
 					);
 
@@ -112,9 +155,114 @@ class MetaModelCsvOutput :
 			const fpmas::scheduler::JobList& jobs() {
 				return _jobs;
 			}
+
+			/**
+			 * Flushes the CSV file and returns its current size, in bytes.
+			 */
+			std::size_t offset();
 	};
 
 
+/**
+ * One-off CSV output of the warm-up phase of a MetaModel.
+ *
+ * During the warm-up phase, the model runs normally but probes are committed
+ * to a dedicated monitor instead of the MetaModelCsvOutput one, so that the
+ * initial load balancing, that moves nearly everything from the arbitrary
+ * initial placement, is not counted in steady phase measures.
+ *
+ * A single row is written by each process at the end of the warm-up phase to
+ * its own CSV file, with the following fields:
+ * - `WARMUP_STEPS`: count of warm-up time steps
+ * - `LB_COUNT`: count of load balancing operations performed during warm-up
+ * - `BALANCE_TIME`: total time spent in load balancing algorithms during
+ *   warm-up
+ * - `DISTRIBUTE_TIME`: total time spent distributing the model during
+ *   warm-up
+ * - `CELL_SYNC`: total time spent synchronizing cell interactions during
+ *   warm-up
+ * - `POPULATION`: count of LOCAL agents at the end of the warm-up phase
+ *
+ * See MetaModelCsvOutput for a detailed description of time fields.
+ *
+ * Only built if ModelConfig::warmup_steps > 0. When a run is restarted after
+ * its warm-up phase, the output is not built again, so that the warm-up file
+ * of the interrupted run is preserved.
+ */
+class WarmupCsvOutput :
+	public fpmas::io::FileOutput,
+	public fpmas::io::CsvOutput<
+		fpmas::scheduler::TimeStep, // Warm-up steps
+		unsigned int, // LB count
+		unsigned int, // Partitioning time
+		unsigned int, // Distribution time
+		unsigned int, // Sync time
+		std::size_t // Population
+	> {
+		private:
+			fpmas::scheduler::detail::LambdaTask commit_probes_task;
+			fpmas::scheduler::Job _commit_job {{commit_probes_task}};
+
+		public:
+			/**
+			 * WarmupCsvOutput constructor.
+			 *
+			 * The name of the output CSV file is set as
+			 * "[model name].warmup.\%r.csv.part" where \%r is the rank of the
+			 * current process, renamed by commit_outputs() once the run is
+			 * complete.
+			 *
+			 * @param meta_model Model from which data is gathered
+			 * @param warmup_steps Count of warm-up time steps
+			 * @param balance_probe `BALANCE_TIME` probe
+			 * @param distribute_probe `DISTRIBUTE_TIME` probe
+			 * @param local_read_probe Probe discarded during warm-up
+			 * @param local_write_probe Probe discarded during warm-up
+			 * @param distant_read_probe Probe discarded during warm-up
+			 * @param distant_write_probe Probe discarded during warm-up
+			 * @param sync_probe `CELL_SYNC` probe
+			 * @param contact_local_read_probe Probe discarded during warm-up
+			 * @param contact_local_write_probe Probe discarded during warm-up
+			 * @param contact_distant_read_probe Probe discarded during warm-up
+			 * @param contact_distant_write_probe Probe discarded during warm-up
+			 * @param contact_sync_probe Probe discarded during warm-up
+			 * @param monitor Monitor dedicated to the warm-up phase
+			 */
+			WarmupCsvOutput(
+					BasicMetaModel& meta_model,
+					fpmas::scheduler::TimeStep warmup_steps,
+					fpmas::api::utils::perf::Probe& balance_probe,
+					fpmas::api::utils::perf::Probe& distribute_probe,
+					fpmas::api::utils::perf::Probe& local_read_probe,
+					fpmas::api::utils::perf::Probe& local_write_probe,
+					fpmas::api::utils::perf::Probe& distant_read_probe,
+					fpmas::api::utils::perf::Probe& distant_write_probe,
+					fpmas::api::utils::perf::Probe& sync_probe,
+					fpmas::api::utils::perf::Probe& contact_local_read_probe,
+					fpmas::api::utils::perf::Probe& contact_local_write_probe,
+					fpmas::api::utils::perf::Probe& contact_distant_read_probe,
+					fpmas::api::utils::perf::Probe& contact_distant_write_probe,
+					fpmas::api::utils::perf::Probe& contact_sync_probe,
+					fpmas::api::utils::perf::Monitor& monitor
+					);
+
+			/**
+			 * Job to schedule at each warm-up iteration, in place of
+			 * MetaModelCsvOutput::jobs(), to accumulate probes in the warm-up
+			 * monitor.
+			 */
+			const fpmas::scheduler::Job& commitJob() {
+				return _commit_job;
+			}
+
+			/**
+			 * Writes the warm-up row and flushes the file, so that it is
+			 * preserved if the run is interrupted and restarted after the
+			 * warm-up phase.
+			 */
+			void dump() override;
+	};
+
 /**
  * Dumps the current grid to a `grid.json` file on the process 0 as a 2
  * dimension array such as `json[y][x]` contains the utility of the grid cell at
@@ -2,6 +2,8 @@
 
 #include "fpmas.h"
 #include "fpmas/utils/perf.h"
+#include <mutex>
+#include <unordered_map>
 
 /**
  * @file probe.h
@@ -146,3 +148,59 @@ class SyncProbeTask : public fpmas::scheduler::Task {
 		void run() override;
 };
 
+
+/**
+ * A thread-safe fpmas::api::utils::perf::Probe implementation.
+ *
+ * start() and stop() can be called concurrently from several threads, for
+ * example from tasks executed by a ThreadPool: the start time is stored per
+ * thread, and measured durations are accumulated under a mutex. A single
+ * probe can thus be shared by all the threads of a process, and committed to a
+ * Monitor as usual once the parallel section is complete.
+ */
+class ConcurrentProbe : public fpmas::api::utils::perf::Probe {
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		static thread_local
+			std::unordered_map<const ConcurrentProbe*, Clock::time_point>
+			start_times;
+
+		std::string _label;
+		std::mutex mutex;
+		std::vector<fpmas::api::utils::perf::Duration> _durations;
+
+	public:
+		/**
+		 * ConcurrentProbe constructor.
+		 *
+		 * @param label Label of the probe
+		 */
+		ConcurrentProbe(std::string label) : _label(label) {
+		}
+
+		std::string label() const override {
+			return _label;
+		}
+
+		/**
+		 * Starts a measure for the current thread.
+		 */
+		void start() override;
+
+		/**
+		 * Stops the measure started by the current thread, and records its
+		 * duration.
+		 */
+		void stop() override;
+
+		/**
+		 * Durations recorded by all threads. Must not be called concurrently
+		 * with stop().
+		 */
+		const std::vector<fpmas::api::utils::perf::Duration>& durations() const override {
+			return _durations;
+		}
+
+		void clear() override;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "fpmas/api/model/model.h"
+#include "config.h"
+
+/**
+ * @file snapshot.h
+ * Contains features used to save and reuse initialized MetaModels.
+ */
+
+/**
+ * Computes a key that identifies the environment built from the specified
+ * configuration.
+ *
+ * Only fields that have an impact on the initialization of the MetaModel are
+ * taken into account (environment type and size, utilities, cell and agent
+ * weights, groups, seed...), so that MetaModels that only differ by their
+ * load balancing or synchronization configuration share the same key.
+ *
+ * @param config Model configuration
+ * @param process_count Count of processes on which the model is distributed
+ * @return hexadecimal key
+ */
+std::string environment_key(const ModelConfig& config, int process_count);
+
+/**
+ * A binary snapshot of an initialized MetaModel, i.e. of its Cell network and
+ * Spatial Agents, including node weights, edges, cell data and the initial
+ * partition.
+ *
+ * Each process dumps and loads its own part of the model to/from the
+ * `<environment_snapshot>/env-<key>.<rank>.bin` file, where `key` is computed
+ * by environment_key(). Loading a snapshot is thus performed in parallel, and
+ * requires the same process count as the one used to dump it.
+ *
+ * Snapshots are produced with the FPMAS model datapack breakpoints.
+ */
+class EnvironmentSnapshot {
+	private:
+		fpmas::api::communication::MpiCommunicator& comm;
+		std::string filename;
+
+	public:
+		/**
+		 * EnvironmentSnapshot constructor.
+		 *
+		 * @param config Model configuration. The `environment_snapshot` field
+		 * specifies the directory of snapshot files.
+		 * @param comm Communicator on which the model is distributed
+		 */
+		EnvironmentSnapshot(
+				const ModelConfig& config,
+				fpmas::api::communication::MpiCommunicator& comm);
+
+		/**
+		 * Name of the snapshot file of the current process.
+		 */
+		const std::string& file() const {
+			return filename;
+		}
+
+		/**
+		 * Returns true iff a snapshot file is available on **all**
+		 * processes.
+		 *
+		 * Must be called on all processes.
+		 */
+		bool exists() const;
+
+		/**
+		 * Dumps the local part of the model to the snapshot file.
+		 *
+		 * The file is written under a temporary name, unique to the current
+		 * process, and then renamed, so that an interrupted dump is never
+		 * considered as a valid snapshot, even if several groups of test
+		 * cases dump the same snapshot concurrently.
+		 *
+		 * @param model Initialized model to dump
+		 */
+		void dump(const fpmas::api::model::Model& model) const;
+
+		/**
+		 * Loads the local part of the model from the snapshot file.
+		 *
+		 * Groups of the model must already be built, so that loaded agents can
+		 * be added to them.
+		 *
+		 * @param model Model to load
+		 */
+		void load(fpmas::api::model::Model& model) const;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "yaml-cpp/yaml.h"
+#include <ostream>
+
+/**
+ * @file sweep.h
+ * Contains features used to expand parameter sweeps declared in the
+ * configuration file.
+ */
+
+/**
+ * A point of a parameter sweep, i.e. a complete configuration.
+ */
+struct SweepPoint {
+	/**
+	 * Configuration of the point, without the `sweep` field.
+	 */
+	YAML::Node config;
+	/**
+	 * Self-describing name of the point, built from its parameters, such as
+	 * `occupation_rate=0.1+sync_mode=GHOST_MODE`. Empty if the configuration
+	 * does not declare a sweep.
+	 */
+	std::string name;
+	/**
+	 * Swept fields, in the order of the `sweep` declaration, with the value
+	 * of each field for this point.
+	 */
+	std::vector<std::pair<std::string, std::string>> parameters;
+};
+
+/**
+ * Expands the parameter sweep declared in the `sweep` field of the specified
+ * configuration.
+ *
+ * The `sweep` field is defined as:
+ * ```yaml
+ * sweep:
+ *   mode: PRODUCT # or ZIP
+ *   fields:
+ *     occupation_rate: [0.1, 0.5]
+ *     sync_mode: [GHOST_MODE, HARD_SYNC_MODE]
+ *     MetaAgentBase.range_size: [1, 2]
+ * ```
+ * Each swept field replaces the corresponding field of the configuration.
+ * Nested fields are specified with a dot-separated path. In `PRODUCT` mode,
+ * the cartesian product of all the values is expanded, the last field
+ * varying the fastest. In `ZIP` mode, all lists must have the same size, and
+ * the i-th point uses the i-th value of each list.
+ *
+ * Scalar values are used as is in point names, while other values, such as
+ * lists of attractors, are replaced by their index in the list of values.
+ *
+ * @param config YAML configuration
+ * @return expanded configurations, or an empty list if the `sweep` field is
+ * not valid. If no `sweep` field is defined, a single point with an empty
+ * name and the original configuration is returned.
+ */
+std::vector<SweepPoint> expand_sweep(const YAML::Node& config);
+
+/**
+ * Writes a CSV index of the specified sweep points, with a `NAME` field and
+ * a field for each swept parameter.
+ *
+ * @param output Output stream
+ * @param sweep Sweep points, as returned by expand_sweep()
+ */
+void write_sweep_index(std::ostream& output, const std::vector<SweepPoint>& sweep);
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <atomic>
+
+/**
+ * @file thread_pool.h
+ * Contains features used to execute MetaModel behaviors on several threads
+ * within each process.
+ */
+
+/**
+ * A work stealing thread pool.
+ *
+ * Iterations of parallelFor() are split in chunks, that are initially
+ * distributed among per thread queues. Each thread processes its own queue from
+ * the back, and steals chunks from the front of the queues of other threads
+ * once its own queue is empty, so that the load is balanced even if the
+ * execution time of iterations is not uniform.
+ *
+ * The thread that calls parallelFor() takes part to the execution, so a pool
+ * of size `n` only starts `n-1` extra threads. A pool of size 1 executes
+ * iterations sequentially, without any synchronization overhead.
+ */
+class ThreadPool {
+	private:
+		// A range of iterations [begin, end)
+		typedef std::pair<std::size_t, std::size_t> Chunk;
+
+		struct Queue {
+			std::mutex mutex;
+			std::deque<Chunk> chunks;
+		};
+
+		static thread_local std::size_t _thread_index;
+
+		std::vector<std::unique_ptr<Queue>> queues;
+		std::vector<std::thread> threads;
+
+		std::mutex mutex;
+		std::condition_variable start_condition;
+		std::condition_variable done_condition;
+		std::function<void(std::size_t)> task;
+		std::size_t generation = 0;
+		std::size_t remaining_chunks = 0;
+		bool stop = false;
+
+		bool pop(std::size_t thread_index, Chunk& chunk);
+		void work(std::size_t thread_index);
+		void workerLoop(std::size_t thread_index);
+
+	public:
+		/**
+		 * ThreadPool constructor.
+		 *
+		 * @param size Count of threads, including the calling thread. 0 is
+		 * considered as 1.
+		 */
+		ThreadPool(std::size_t size);
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * Count of threads of the pool, including the calling thread.
+		 */
+		std::size_t size() const {
+			return queues.size();
+		}
+
+		/**
+		 * Index of the current thread in its pool, in `[0, size())`. 0 for
+		 * the thread that calls parallelFor(), or any thread outside of a
+		 * pool.
+		 */
+		static std::size_t threadIndex() {
+			return _thread_index;
+		}
+
+		/**
+		 * Calls `task(i)` for each `i` in `[0, count)`, distributing
+		 * iterations among the threads of the pool, and returns once all the
+		 * iterations are complete.
+		 *
+		 * `task` must be safe to call concurrently for different values of
+		 * `i`.
+		 *
+		 * @param count Count of iterations
+		 * @param task Task to execute for each iteration
+		 * @param grain_size Count of iterations of each chunk. If 0, a grain
+		 * size that produces about 8 chunks per thread is used.
+		 */
+		void parallelFor(
+				std::size_t count, std::function<void(std::size_t)> task,
+				std::size_t grain_size = 0);
+
+		/**
+		 * Stops and joins all the threads of the pool.
+		 */
+		~ThreadPool();
+};
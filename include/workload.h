@@ -0,0 +1,68 @@
+#pragma once
+
+#include "config.h"
+
+/**
+ * @file workload.h
+ * Contains the synthetic compute kernel and cell payloads used to emulate the
+ * computation and communication costs of agents and cells.
+ */
+
+/**
+ * Performs approximately `flops` floating point operations.
+ *
+ * The kernel is a dense multiply-add loop over a small array that fits in
+ * registers, so that it is vectorized by the compiler and that its cost only
+ * depends on the count of operations, not on memory accesses. The kernel is
+ * thread safe.
+ *
+ * @param flops Count of floating point operations
+ * @return Result of the computation, that is not relevant
+ */
+float workload_kernel(float flops);
+
+/**
+ * Draws the workload of an instance from the specified Workload
+ * configuration, using the
+ * [RandomNeighbors::rd](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1RandomNeighbors.html)
+ * generator.
+ *
+ * @param workload Workload configuration
+ * @param utility For WorkloadDistribution::UTILITY, utility of the cell, or
+ * of the location of the agent
+ * @param mean_utility For WorkloadDistribution::UTILITY, mean utility of all
+ * cells
+ * @return Count of floating point operations performed by each behavior of
+ * the instance
+ */
+float draw_workload(const Workload& workload, float utility, float mean_utility);
+
+/**
+ * Returns the weight of an instance with the specified workload, i.e.
+ * `base_weight` scaled by the ratio between `instance_workload` and the mean
+ * workload. `base_weight` is returned if the kernel is disabled.
+ *
+ * @param base_weight Weight of an instance with the mean workload
+ * @param workload Workload configuration
+ * @param instance_workload Workload of the instance
+ */
+float workload_weight(
+		float base_weight, const Workload& workload, float instance_workload);
+
+/**
+ * Draws the size of the data of a cell from the specified distribution, using
+ * the
+ * [RandomNeighbors::rd](https://fpmas.github.io/FPMAS/classfpmas_1_1model_1_1RandomNeighbors.html)
+ * generator.
+ *
+ * @param distribution Cell size distribution
+ * @param cell_size Mean size, in bytes
+ * @param sigma Shape of the LOGNORMAL distribution
+ * @param utility For CellSizeDistribution::UTILITY, utility of the cell
+ * @param mean_utility For CellSizeDistribution::UTILITY, mean utility of all
+ * cells
+ * @return Size of the data of the cell, in bytes
+ */
+std::size_t draw_cell_size(
+		CellSizeDistribution distribution, std::size_t cell_size, float sigma,
+		float utility, float mean_utility);
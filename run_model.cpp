@@ -1,10 +1,20 @@
 #include "fpmas.h"
 #include "metamodel.h"
-#include "fpmas/model/spatial/cell_load_balancing.h"
+#include "ensemble.h"
+#include "autotune.h"
+#include "load_balancing.h"
+#include "estimate.h"
+#include "sweep.h"
+#include "campaign.h"
 #include "CLI/App.hpp"
 #include "CLI/Formatter.hpp"
 #include "CLI/Config.hpp"
 #include "yaml-cpp/node/parse.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
 
 
 FPMAS_BASE_DATAPACK_SET_UP(
@@ -27,6 +37,310 @@ FPMAS_BASE_JSON_SET_UP(
 
 using namespace fpmas::synchro;
 
+/**
+ * Initializes the specified model, or restarts it from its last checkpoint,
+ * then runs and deletes it.
+ *
+ * @return run time, in seconds, excluding initialization
+ */
+double run(BasicMetaModel* model, bool restart) {
+	if(restart)
+		model->restart();
+	else
+		model->init();
+	auto start = std::chrono::steady_clock::now();
+	model->run();
+	auto end = std::chrono::steady_clock::now();
+	delete model;
+	return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * Validates the configuration of all sweep points, and loads all the load
+ * balancing plugins they require, before the first run.
+ *
+ * Processes agree on the result, so that either all processes run the
+ * campaign or none does.
+ *
+ * @return true iff all sweep points can be run on all processes
+ */
+bool load_sweep(const std::vector<SweepPoint>& sweep) {
+	int invalid = sweep.empty() ? 1 : 0;
+	for(auto& point : sweep) {
+		ModelConfig config(point.config);
+		config.applyWeakScaling(fpmas::communication::WORLD.getSize());
+		config.validate();
+		if(!config.is_valid) {
+			invalid = 1;
+			continue;
+		}
+		for(auto& test_case : config.test_cases) {
+			if(!test_case.plugin.empty()) {
+				if(!LoadBalancingRegistry::load(
+							test_case.algorithm, test_case.plugin))
+					invalid = 1;
+			} else if(!LoadBalancingRegistry::contains(test_case.algorithm)) {
+				std::cerr << "[FATAL ERROR] Unknown load balancing algorithm: "
+					<< test_case.algorithm << std::endl;
+				invalid = 1;
+			}
+		}
+	}
+	fpmas::communication::TypedMpi<int> mpi(fpmas::communication::WORLD);
+	return fpmas::communication::all_reduce(mpi, invalid, std::plus<int>()) == 0;
+}
+
+/**
+ * Hash of the parameters that define a run, used to detect runs of a resumed
+ * campaign whose configuration changed.
+ *
+ * Test cases and parameters that only control outputs, checkpoints or
+ * snapshots are excluded, since they do not change the results of the run.
+ *
+ * The result of the autotuning search depends on measured timings: the hash
+ * of an autotuned run is computed from the inputs of the search, i.e. the
+ * `autotune_*` parameters and the candidate periods, instead of the tuned
+ * parameters, so that it is stable across resumed campaigns.
+ *
+ * @param point_config YAML configuration of the sweep point
+ * @param config configuration of the sweep point, with parameters resolved by
+ * weak scaling
+ * @param algorithm load balancing algorithm of the run
+ * @param lb_periods load balancing period of the run, or candidate periods of
+ * an autotuned run
+ * @param seed seed of the run
+ * @param autotune true iff the run is autotuned
+ * @return hexadecimal hash
+ */
+std::string run_hash(
+		const YAML::Node& point_config, const ModelConfig& config,
+		std::string algorithm,
+		const std::vector<fpmas::scheduler::TimeStep>& lb_periods,
+		unsigned long seed, bool autotune) {
+	YAML::Node node = YAML::Clone(point_config);
+	for(auto field : {
+			"test_cases", "json_output", "json_output_period", "dot_output",
+			"checkpoint_period", "environment_snapshot"})
+		node.remove(field);
+	if(autotune) {
+		node["autotune_steps"] = config.autotune_steps;
+		node["autotune_imbalance_tol"] = config.autotune_imbalance_tol;
+		node["autotune_iterations"] = config.autotune_iterations;
+	} else {
+		for(auto field : {
+				"autotune_steps", "autotune_imbalance_tol", "autotune_iterations"})
+			node.remove(field);
+	}
+	node["grid_width"] = config.grid_width;
+	node["grid_height"] = config.grid_height;
+	node["num_cells"] = config.num_cells;
+	node["occupation_rate"] = config.occupation_rate;
+	node["zoltan_imbalance_tol"] = config.zoltan_imbalance_tol;
+	node["algorithm"] = algorithm;
+	node["lb_periods"] = lb_periods;
+	node["autotune"] = autotune;
+	node["seed"] = seed;
+	node["processes"] = fpmas::communication::WORLD.getSize();
+	return config_hash(node);
+}
+
+/**
+ * Lower case name of the load balancing algorithm.
+ */
+std::string algorithm_name(std::string algorithm) {
+	std::string name = algorithm;
+	std::transform(
+			name.begin(), name.end(), name.begin(),
+			[] (const char& c) {return std::tolower(c);});
+	return name;
+}
+
+/**
+ * Name of the test case, used as a prefix of output files.
+ */
+std::string test_case_name(
+		std::string algorithm, fpmas::scheduler::TimeStep lb_period) {
+	return algorithm_name(algorithm) + "-" + std::to_string(lb_period);
+}
+
+/**
+ * Builds the load balancing algorithm and the MetaModel of a test case, then
+ * runs it.
+ *
+ * @return local run time, in seconds, excluding initialization
+ */
+double run_test_case(
+		MetaModelFactory& model_factory, const ModelConfig& config,
+		std::string algorithm, fpmas::scheduler::TimeStep lb_period,
+		std::string name, bool restart) {
+	fpmas::scheduler::Scheduler scheduler;
+	fpmas::runtime::Runtime runtime(scheduler);
+
+	auto lb_algorithm = LoadBalancingRegistry::build(
+			algorithm, {
+			config, lb_period, scheduler, runtime, fpmas::communication::WORLD
+			});
+	BasicMetaModel* model = model_factory.build(
+			name, config,
+			scheduler, runtime, lb_algorithm->loadBalancing(), lb_period
+			);
+	return run(model, restart);
+}
+
+/**
+ * Searches the best load balancing period among the `lb_periods` of the
+ * specified test case, and the best Zoltan IMBALANCE_TOL if the algorithm
+ * relies on Zoltan, using short probe runs.
+ *
+ * The search trace is written to `<name>.autotune.csv`, and the best
+ * configuration to `<name>.autotune.yml`, by the process 0.
+ *
+ * @param model_factory MetaModel factory
+ * @param config Model configuration, updated with the best IMBALANCE_TOL
+ * @param test_case Test case, which lb_periods are replaced by the best
+ * period
+ * @param name Prefix of output files
+ */
+void autotune_test_case(
+		MetaModelFactory& model_factory, ModelConfig& config,
+		TestCaseConfig& test_case, std::string name) {
+	std::string rank = std::to_string(fpmas::communication::WORLD.getRank());
+	ModelConfig probe_config = config;
+	probe_config.warmup_steps = 0;
+	probe_config.checkpoint_period = 0;
+	probe_config.json_output = false;
+	probe_config.dot_output = false;
+
+	std::size_t trial = 0;
+	Autotune autotune([&] (
+				fpmas::scheduler::TimeStep lb_period, float imbalance_tol,
+				fpmas::scheduler::TimeStep steps) {
+			probe_config.num_steps = steps;
+			probe_config.zoltan_imbalance_tol = imbalance_tol;
+			std::string probe_name
+				= name + ".autotune-" + std::to_string(trial++);
+			double time = run_test_case(
+					model_factory, probe_config, test_case.algorithm,
+					lb_period, probe_name, false);
+			// Probe runs outputs are not relevant
+			std::remove((probe_name + "." + rank + ".csv.part").c_str());
+			std::remove((probe_name + ".warmup." + rank + ".csv.part").c_str());
+
+			// The slowest process determines the run time
+			fpmas::communication::TypedMpi<double> mpi(
+					fpmas::communication::WORLD);
+			return fpmas::communication::all_reduce(
+					mpi, time, [] (const double& t1, const double& t2) {
+					return std::max(t1, t2);
+					});
+			});
+
+	autotune.tuneLbPeriod(
+			test_case.lb_periods, config.zoltan_imbalance_tol,
+			config.autotune_steps, config.num_steps);
+	if(LoadBalancingRegistry::usesImbalanceTol(test_case.algorithm))
+		autotune.tuneImbalanceTol(
+				config.autotune_imbalance_tol[0],
+				config.autotune_imbalance_tol[1],
+				config.autotune_iterations,
+				std::min(
+					std::max(
+						config.autotune_steps, autotune.bestLbPeriod() + 1),
+					config.num_steps)
+				);
+
+	test_case.lb_periods = {autotune.bestLbPeriod()};
+	config.zoltan_imbalance_tol = autotune.bestImbalanceTol();
+
+	if(fpmas::communication::WORLD.getRank() == 0) {
+		std::ofstream trace(name + ".autotune.csv");
+		autotune.writeTrace(trace);
+
+		YAML::Node best;
+		best["zoltan_imbalance_tol"] = config.zoltan_imbalance_tol;
+		best["test_cases"].push_back(test_case);
+		std::ofstream best_config(name + ".autotune.yml");
+		best_config << best << std::endl;
+	}
+}
+
+/**
+ * Estimates the per process memory and communication costs of the model
+ * from a small sample build, using the load balancing algorithm of the first
+ * test case.
+ *
+ * Each process writes its own estimate to `<prefix>estimate.<rank>.csv`, and
+ * the maximum of each field among processes is printed by the process 0.
+ *
+ * @param model_factory MetaModel factory
+ * @param config Full configuration
+ * @param prefix Prefix of the output file name
+ */
+void estimate(
+		MetaModelFactory& model_factory, const ModelConfig& config,
+		std::string prefix) {
+	int process_count = fpmas::communication::WORLD.getSize();
+	std::string rank = std::to_string(fpmas::communication::WORLD.getRank());
+	ModelConfig sample = sample_config(config, process_count);
+	const TestCaseConfig& test_case = config.test_cases.at(0);
+
+	CostEstimate sample_costs;
+	{
+		std::size_t initial_memory = resident_memory();
+		fpmas::scheduler::Scheduler scheduler;
+		fpmas::runtime::Runtime runtime(scheduler);
+		auto lb_algorithm = LoadBalancingRegistry::build(
+				test_case.algorithm, {
+				sample, test_case.lb_periods.at(0), scheduler, runtime,
+				fpmas::communication::WORLD
+				});
+		BasicMetaModel* model = model_factory.build(
+				"estimate-sample", sample,
+				scheduler, runtime, lb_algorithm->loadBalancing(),
+				test_case.lb_periods.at(0)
+				);
+		// Initial load balancing and a single time step
+		model->init()->run();
+		sample_costs = measure_costs(*model);
+		std::size_t memory = resident_memory();
+		sample_costs.memory_bytes
+			= memory > initial_memory ? memory - initial_memory : 0;
+		delete model;
+		std::remove(("estimate-sample." + rank + ".csv.part").c_str());
+		std::remove(("estimate-sample.warmup." + rank + ".csv.part").c_str());
+	}
+
+	CostEstimate costs = extrapolate_costs(
+			sample_costs, sample, config, process_count);
+	std::ofstream output(prefix + "estimate." + rank + ".csv");
+	write_estimate_header(output);
+	write_estimate(output, costs);
+
+	fpmas::communication::TypedMpi<double> mpi(fpmas::communication::WORLD);
+	auto max = [] (const double& v1, const double& v2) {
+		return std::max(v1, v2);
+	};
+	CostEstimate max_costs;
+	for(auto field : {
+			&CostEstimate::local_cells, &CostEstimate::local_agents,
+			&CostEstimate::ghost_cells, &CostEstimate::ghost_agents,
+			&CostEstimate::cell_edges, &CostEstimate::distant_cell_edges,
+			&CostEstimate::agent_edges, &CostEstimate::distant_agent_edges,
+			&CostEstimate::cell_bytes, &CostEstimate::agent_bytes,
+			&CostEstimate::memory_bytes, &CostEstimate::step_message_bytes
+			})
+		max_costs.*field = fpmas::communication::all_reduce(
+				mpi, costs.*field, max);
+	if(fpmas::communication::WORLD.getRank() == 0) {
+		if(!prefix.empty())
+			std::cout << prefix.substr(0, prefix.size()-1) << std::endl;
+		std::cout << "Estimated costs, maximum among " << process_count
+			<< " processes:" << std::endl;
+		write_estimate_header(std::cout);
+		write_estimate(std::cout, max_costs);
+	}
+}
+
 int main(int argc, char** argv) {
 	FPMAS_REGISTER_AGENT_TYPES(
 			GridCell::JsonBase,
@@ -42,108 +356,254 @@ int main(int argc, char** argv) {
 		->required();
 	unsigned long seed = fpmas::random::default_seed;
 	app.add_option("-s,--seed", seed, "Random seed");
+	unsigned int groups = 1;
+	app.add_option(
+			"-g,--groups", groups,
+			"Count of groups among which test cases are distributed")
+		->check(CLI::PositiveNumber);
+	unsigned int group_id = 0;
+	app.add_option(
+			"--group-id", group_id,
+			"Group of test cases run by this invocation, in [0, groups)");
+	bool restart = false;
+	app.add_flag(
+			"--restart", restart,
+			"Restarts test cases from their last checkpoint, if available");
+	bool resume = false;
+	app.add_flag(
+			"--resume", resume,
+			"Skips runs already completed according to the campaign manifest, "
+			"and restarts other runs from their last checkpoint, if available");
+	std::size_t ensemble = 1;
+	app.add_option(
+			"-e,--ensemble", ensemble,
+			"Count of seeds run for each test case, generated from the base seed")
+		->check(CLI::PositiveNumber);
+	bool reject_outliers = false;
+	app.add_flag(
+			"--reject-outliers", reject_outliers,
+			"Ignores values outside of Tukey fences in ensemble statistics");
+	bool estimate_mode = false;
+	app.add_flag(
+			"--estimate", estimate_mode,
+			"Only estimates per process memory and communication costs from "
+			"a small sample build");
+	bool autotune_mode = false;
+	app.add_flag(
+			"--autotune", autotune_mode,
+			"Tunes lb_period and zoltan_imbalance_tol of each test case before "
+			"running it");
 
 	CLI11_PARSE(app, argc, argv);
+	if(group_id >= groups) {
+		std::cerr << "[FATAL ERROR] --group-id must be lower than --groups"
+			<< std::endl;
+		return EXIT_FAILURE;
+	}
 
 	fpmas::seed(seed);
 	random_interactions.seed(seed);
 
 	fpmas::init(argc, argv);
+	std::vector<SweepPoint> sweep = expand_sweep(YAML::LoadFile(config_file));
+	if(!load_sweep(sweep)) {
+		fpmas::finalize();
+		return EXIT_FAILURE;
+	}
 	{
-		ModelConfig config(YAML::LoadFile(config_file));
-		if(!config.is_valid)
-			return EXIT_FAILURE;
-
-		MetaModelFactory model_factory(config.environment, config.sync_mode);
-
-		for(auto test_case : config.test_cases) {
-			for(auto lb_period : test_case.lb_periods) {
-				fpmas::scheduler::Scheduler scheduler;
-				fpmas::runtime::Runtime runtime(scheduler);
-
-				switch(test_case.algorithm) {
-					case LbAlgorithm::ZOLTAN_LB:
-						{
-							ZoltanLoadBalancing zoltan_lb(
-									fpmas::communication::WORLD, lb_period, config.zoltan_imbalance_tol);
-							BasicMetaModel* model = model_factory.build(
-									"zoltan_lb-" + std::to_string(lb_period), config,
-									scheduler, runtime, zoltan_lb, lb_period
-									);
-							model->init()->run();
-							delete model;
-						}
-						break;
-					case LbAlgorithm::SCHEDULED_LB:
-						{
-							ZoltanLoadBalancing zoltan_lb(
-									fpmas::communication::WORLD, lb_period, config.zoltan_imbalance_tol);
-							ScheduledLoadBalancing scheduled_load_balancing(
-									zoltan_lb, scheduler, runtime
-									);
-							BasicMetaModel* model = model_factory.build(
-									"scheduled_lb-" + std::to_string(lb_period), config,
-									scheduler, runtime, scheduled_load_balancing,
-									lb_period
-									);
-							model->init()->run();
-							delete model;
+		if(sweep.size() > 1 && fpmas::communication::WORLD.getRank() == 0) {
+			std::ofstream index("sweep.csv");
+			write_sweep_index(index, sweep);
+		}
+		// Each group has its own manifest, since groups might run
+		// concurrently
+		CampaignManifest manifest(
+				"campaign" + (groups > 1 ? "-g" + std::to_string(group_id) : "")
+				+ ".manifest.csv");
+		int rank = fpmas::communication::WORLD.getRank();
+		fpmas::communication::TypedMpi<int> int_mpi(
+				fpmas::communication::WORLD);
+		// Index of the current (algorithm, lb_period) pair, in the order of
+		// the configuration file, across all sweep points
+		std::size_t test_case_index = 0;
+		for(auto& point : sweep) {
+			// The configuration was validated by load_sweep(), but must be
+			// loaded again since some parameters are static
+			ModelConfig config(point.config);
+			config.seed = seed;
+			config.applyWeakScaling(fpmas::communication::WORLD.getSize());
+			// The same seeds are used for all test cases, so that load balancing
+			// algorithms are compared on the same model instances
+			std::vector<unsigned long> seeds = ensemble_seeds(seed, ensemble);
+
+			// Built for each sweep point, since the environment and the
+			// synchronization mode might be swept
+			MetaModelFactory model_factory(config.environment, config.sync_mode);
+			// Sweep parameters are prepended to output names
+			std::string name_prefix = point.name.empty() ? "" : point.name + "-";
+			if(estimate_mode) {
+				estimate(model_factory, config, name_prefix);
+				continue;
+			}
+			// The group id is appended to output names only when test cases are
+			// actually split, so that default file names are preserved
+			std::string name_suffix
+				= groups > 1 ? "-g" + std::to_string(group_id) : "";
+			// In weak scaling mode, the count of processes is appended to output
+			// names, so that outputs of a whole campaign can be written to the
+			// same directory
+			if(config.weakScaling())
+				name_suffix = "-n" + std::to_string(
+						fpmas::communication::WORLD.getSize()) + name_suffix;
+
+			// Name of the test case, and of each of its runs
+			auto case_name = [&] (
+					std::string algorithm, fpmas::scheduler::TimeStep lb_period) {
+				return name_prefix + test_case_name(algorithm, lb_period)
+					+ name_suffix;
+			};
+			auto run_name_of = [&] (
+					std::string algorithm, fpmas::scheduler::TimeStep lb_period,
+					std::size_t i) {
+				return case_name(algorithm, lb_period)
+					+ (ensemble > 1 ? "-s" + std::to_string(i) : "");
+			};
+
+			for(auto test_case : config.test_cases) {
+				ModelConfig case_config = config;
+				// In autotune mode, lb_periods are the candidates of a single
+				// test case, from which the hash of its runs is computed
+				const std::vector<fpmas::scheduler::TimeStep> candidates
+					= test_case.lb_periods;
+				if(autotune_mode) {
+					if(test_case_index++ % groups != group_id)
+						continue;
+					// The tuning is skipped if all the runs of the test case
+					// are complete, with the same tuned period
+					int tuned = 0;
+					fpmas::scheduler::TimeStep tuned_lb_period = 0;
+					if(resume) {
+						if(rank == 0) {
+							tuned = 1;
+							for(std::size_t i = 0; i < seeds.size() && tuned; i++) {
+								const CampaignEntry* run = manifest.completeRun(
+										run_hash(
+											point.config, config,
+											test_case.algorithm, candidates,
+											seeds[i], true),
+										seeds[i]);
+								if(run == nullptr
+										|| (i > 0 && run->lb_period != tuned_lb_period))
+									tuned = 0;
+								else
+									tuned_lb_period = run->lb_period;
+							}
 						}
-						break;
-					case LbAlgorithm::GRID_LB:
-						{
-							GridLoadBalancing grid_lb(
-									config.grid_width, config.grid_height,
-									fpmas::communication::WORLD
-									);
-							BasicMetaModel* model = model_factory.build(
-									"grid_lb-" + std::to_string(lb_period), config,
-									scheduler, runtime, grid_lb, lb_period
-									);
-							model->init()->run();
-							delete model;
+						fpmas::communication::TypedMpi<fpmas::scheduler::TimeStep>
+							time_step_mpi(fpmas::communication::WORLD);
+						tuned = fpmas::communication::all_reduce(
+								int_mpi, tuned, std::plus<int>());
+						tuned_lb_period = fpmas::communication::all_reduce(
+								time_step_mpi, tuned_lb_period,
+								std::plus<fpmas::scheduler::TimeStep>());
+						if(tuned) {
+							// Outputs must also be available on all processes
+							int missing = 0;
+							for(std::size_t i = 0; i < seeds.size(); i++)
+								if(!std::ifstream(run_name_of(
+												test_case.algorithm, tuned_lb_period, i)
+											+ "." + std::to_string(rank) + ".csv").good())
+									missing = 1;
+							tuned = fpmas::communication::all_reduce(
+									int_mpi, missing, std::plus<int>()) == 0;
 						}
-						break;
-					case LbAlgorithm::ZOLTAN_CELL_LB:
-						{
-							ZoltanLoadBalancing zoltan_lb(
-									fpmas::communication::WORLD, lb_period, config.zoltan_imbalance_tol);
-							CellLoadBalancing zoltan_cell_lb(
-									fpmas::communication::WORLD, zoltan_lb
-									);
-							BasicMetaModel* model = model_factory.build(
-									"zoltan_cell_lb-" + std::to_string(lb_period), config,
-									scheduler, runtime, zoltan_cell_lb, lb_period
-									);
-							model->init()->run();
-							delete model;
+					}
+					if(tuned)
+						test_case.lb_periods = {tuned_lb_period};
+					else
+						autotune_test_case(
+								model_factory, case_config, test_case,
+								name_prefix + algorithm_name(test_case.algorithm)
+								+ name_suffix);
+				}
+				for(auto lb_period : test_case.lb_periods) {
+					// Test cases are distributed among groups in a round-robin
+					// fashion
+					if(!autotune_mode && test_case_index++ % groups != group_id)
+						continue;
+					std::string name = case_name(test_case.algorithm, lb_period);
+					std::vector<std::string> csv_files;
+					for(std::size_t i = 0; i < seeds.size(); i++) {
+						std::string run_name
+							= run_name_of(test_case.algorithm, lb_period, i);
+						// Each run is seeded independently, so that a resumed
+						// campaign produces the same runs as an uninterrupted
+						// one
+						fpmas::seed(seeds[i]);
+						random_interactions.seed(seeds[i]);
+						case_config.seed = seeds[i];
+						csv_files.push_back(
+								run_name + "." + std::to_string(rank) + ".csv");
+						CampaignEntry entry {
+							run_name,
+							run_hash(
+									point.config, config, test_case.algorithm,
+									autotune_mode ? candidates
+									: std::vector<fpmas::scheduler::TimeStep> {lb_period},
+									seeds[i], autotune_mode),
+							case_config.seed, test_case.algorithm,
+							lb_period, RunStatus::RUNNING
+						};
+						if(resume) {
+							// The run is complete only if it is marked as such
+							// in the manifest and its outputs are available on
+							// all processes
+							int missing = std::ifstream(csv_files.back()).good() ? 0 : 1;
+							if(rank == 0 && !manifest.complete(entry))
+								missing = 1;
+							if(fpmas::communication::all_reduce(
+										int_mpi, missing, std::plus<int>()) == 0)
+								continue;
 						}
-						break;
-					case LbAlgorithm::STATIC_ZOLTAN_CELL_LB:
-						{
-							ZoltanLoadBalancing zoltan_lb(
-									fpmas::communication::WORLD, lb_period, config.zoltan_imbalance_tol);
-							StaticCellLoadBalancing static_cell_lb(fpmas::communication::WORLD, zoltan_lb);
-							BasicMetaModel* model = model_factory.build(
-									"static_zoltan_cell_lb-" + std::to_string(lb_period), config,
-									scheduler, runtime, static_cell_lb, lb_period
-									);
-							model->init()->run();
-							delete model;
+						Checkpoint checkpoint(run_name, fpmas::communication::WORLD);
+						bool restart_case = false;
+						if(restart || resume) {
+							// Only the checkpoint of an interrupted run with the
+							// same configuration hash and seed is restarted, so
+							// that states of different runs are never mixed
+							int stale = rank == 0 && !manifest.running(entry) ? 1 : 0;
+							if(fpmas::communication::all_reduce(
+										int_mpi, stale, std::plus<int>()) == 0)
+								restart_case = checkpoint.exists();
+							if(!restart_case)
+								checkpoint.clear();
 						}
-						break;
-					case LbAlgorithm::RANDOM_LB:
-						{
-
-							RandomLoadBalancing random_lb(fpmas::communication::WORLD);
-							BasicMetaModel* model = model_factory.build(
-									"random_lb-" + std::to_string(lb_period), config,
-									scheduler, runtime, random_lb, lb_period
-									);
-							model->init()->run();
-							delete model;
+						if(restart_case)
+							checkpoint.backupCsv();
+						if(rank == 0)
+							manifest.update(entry);
+
+						run_test_case(
+								model_factory, case_config, test_case.algorithm, lb_period,
+								run_name, restart_case);
+						if(restart_case)
+							checkpoint.mergeCsv();
+						// The test case is complete
+						commit_outputs(run_name, rank);
+						checkpoint.clear();
+						// Outputs must be committed on all processes before
+						// the run is marked as complete
+						fpmas::communication::WORLD.barrier();
+						if(rank == 0) {
+							entry.status = RunStatus::COMPLETE;
+							manifest.update(entry);
 						}
-						break;
+					}
+					if(ensemble > 1)
+						aggregate_ensemble(
+								csv_files,
+								name + ".ensemble." + std::to_string(rank) + ".csv",
+								reject_outliers);
 				}
 			}
 		}
@@ -4,6 +4,31 @@ std::size_t MetaAgentBase::max_contacts;
 std::size_t MetaAgentBase::range_size = 1;
 float MetaAgentBase::contact_weight = 1.0f;
 MovePolicy MetaAgentBase::move_policy = MovePolicy::RANDOM;
+std::vector<Species> MetaAgentBase::species_table;
+Interactions MetaAgentBase::contact_interactions = Interactions::NONE;
+float MetaAgentBase::infection_rate = 0.5f;
+float MetaAgentBase::recovery_rate = 0.1f;
+float MetaAgentBase::initial_infected = 0.01f;
+
+std::size_t MetaAgentBase::rangeSize(std::size_t species) {
+	return species < species_table.size() ?
+		species_table[species].range_size : range_size;
+}
+
+std::size_t MetaAgentBase::maxContacts() const {
+	return _species < species_table.size() ?
+		species_table[_species].max_contacts : max_contacts;
+}
+
+float MetaAgentBase::contactWeight() const {
+	return _species < species_table.size() ?
+		species_table[_species].contact_weight : contact_weight;
+}
+
+MovePolicy MetaAgentBase::movePolicy() const {
+	return _species < species_table.size() ?
+		species_table[_species].move_policy : move_policy;
+}
 
 std::deque<DistributedId>& MetaAgentBase::contacts() {
 	return _contacts;
@@ -17,3 +42,9 @@ bool MetaAgentBase::is_in_contacts(DistributedId id) {
 	return std::find(_contacts.begin(), _contacts.end(), id) != _contacts.end();
 }
 
+
+void MetaAgentBase::commitInfection(bool recover) {
+	if(_infected && recover)
+		_next_infected = false;
+	_infected = _next_infected;
+}
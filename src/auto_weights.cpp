@@ -0,0 +1,46 @@
+#include "auto_weights.h"
+#include <algorithm>
+
+const float AutoWeights::min_weight = 1e-3f;
+
+void AutoWeights::record(
+		fpmas::api::graph::DistributedId id, Clock::duration duration) {
+	step_costs[id] += std::chrono::duration_cast<
+		std::chrono::duration<double, std::micro>>(duration).count();
+}
+
+void AutoWeights::commitStep(fpmas::api::model::AgentGraph& graph) {
+	std::unordered_map<fpmas::api::graph::DistributedId, double> new_costs;
+	for(auto& node : graph.getLocationManager().getLocalNodes()) {
+		auto step_cost = step_costs.find(node.first);
+		double x = step_cost == step_costs.end() ? 0 : step_cost->second;
+		auto previous_cost = costs.find(node.first);
+		new_costs[node.first] = previous_cost == costs.end() ?
+			x : smoothing * x + (1 - smoothing) * previous_cost->second;
+	}
+	costs = std::move(new_costs);
+	step_costs.clear();
+}
+
+double AutoWeights::cost(fpmas::api::graph::DistributedId id) const {
+	auto cost = costs.find(id);
+	return cost == costs.end() ? 0 : cost->second;
+}
+
+void AutoWeights::updateWeights(fpmas::api::model::AgentGraph& graph) const {
+	for(auto& node : graph.getLocationManager().getLocalNodes()) {
+		double weight = cost(node.first);
+		if(communication_cost > 0)
+			for(auto edge : node.second->getOutgoingEdges())
+				if(edge->state() == fpmas::api::graph::DISTANT)
+					weight += communication_cost;
+		node.second->setWeight(std::max((float) weight, min_weight));
+	}
+}
+
+void TimedBehavior::execute(fpmas::api::model::Agent* agent) const {
+	auto start = AutoWeights::Clock::now();
+	behavior.execute(agent);
+	auto_weights.record(
+			agent->node()->getId(), AutoWeights::Clock::now() - start);
+}
@@ -0,0 +1,99 @@
+#include "autotune.h"
+#include <algorithm>
+#include <cmath>
+
+Autotune::Autotune(Objective objective) : objective(objective) {
+}
+
+AutotuneTrial& Autotune::evaluate(
+		std::string phase,
+		fpmas::api::scheduler::TimeStep lb_period,
+		float imbalance_tol,
+		fpmas::api::scheduler::TimeStep steps) {
+	_trace.push_back({
+			phase, lb_period, imbalance_tol, steps,
+			objective(lb_period, imbalance_tol, steps)
+			});
+	return _trace.back();
+}
+
+fpmas::api::scheduler::TimeStep Autotune::tuneLbPeriod(
+		std::vector<fpmas::api::scheduler::TimeStep> lb_periods,
+		float imbalance_tol,
+		fpmas::api::scheduler::TimeStep steps,
+		fpmas::api::scheduler::TimeStep max_steps) {
+	_best_imbalance_tol = imbalance_tol;
+	std::sort(lb_periods.begin(), lb_periods.end());
+	lb_periods.erase(
+			std::unique(lb_periods.begin(), lb_periods.end()),
+			lb_periods.end());
+
+	while(lb_periods.size() > 1) {
+		fpmas::api::scheduler::TimeStep budget = std::min(
+				std::max(steps, lb_periods.back() + 1), max_steps);
+		std::vector<std::pair<double, fpmas::api::scheduler::TimeStep>> results;
+		for(auto lb_period : lb_periods)
+			results.push_back({
+					evaluate("LB_PERIOD", lb_period, imbalance_tol, budget)
+					.time_per_step(),
+					lb_period
+					});
+		std::sort(results.begin(), results.end());
+
+		lb_periods.resize((lb_periods.size() + 1) / 2);
+		for(std::size_t i = 0; i < lb_periods.size(); i++)
+			lb_periods[i] = results[i].second;
+		steps = 2 * budget;
+	}
+	if(!lb_periods.empty())
+		_best_lb_period = lb_periods[0];
+	return _best_lb_period;
+}
+
+float Autotune::tuneImbalanceTol(
+		float min, float max, unsigned int iterations,
+		fpmas::api::scheduler::TimeStep steps) {
+	static const double inverse_phi = (std::sqrt(5.) - 1.) / 2.;
+
+	double a = min;
+	double b = max;
+	double c = b - inverse_phi * (b - a);
+	double d = a + inverse_phi * (b - a);
+	double f_c = evaluate("IMBALANCE_TOL", _best_lb_period, c, steps)
+		.time_per_step();
+	double f_d = evaluate("IMBALANCE_TOL", _best_lb_period, d, steps)
+		.time_per_step();
+	for(unsigned int i = 1; i < iterations; i++) {
+		if(f_c < f_d) {
+			// The minimum is in [a, d]
+			b = d;
+			d = c;
+			f_d = f_c;
+			c = b - inverse_phi * (b - a);
+			f_c = evaluate("IMBALANCE_TOL", _best_lb_period, c, steps)
+				.time_per_step();
+		} else {
+			// The minimum is in [c, b]
+			a = c;
+			c = d;
+			f_c = f_d;
+			d = a + inverse_phi * (b - a);
+			f_d = evaluate("IMBALANCE_TOL", _best_lb_period, d, steps)
+				.time_per_step();
+		}
+	}
+	_best_imbalance_tol = f_c < f_d ? c : d;
+	return _best_imbalance_tol;
+}
+
+void Autotune::writeTrace(std::ostream& output) const {
+	output << "PHASE,LB_PERIOD,IMBALANCE_TOL,STEPS,TIME,TIME_PER_STEP"
+		<< std::endl;
+	for(auto& trial : _trace)
+		output << trial.phase << ","
+			<< trial.lb_period << ","
+			<< trial.imbalance_tol << ","
+			<< trial.steps << ","
+			<< trial.time << ","
+			<< trial.time_per_step() << std::endl;
+}
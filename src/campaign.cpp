@@ -0,0 +1,93 @@
+#include "campaign.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+CampaignManifest::CampaignManifest(std::string filename)
+	: filename(filename) {
+		std::ifstream file(filename);
+		std::string line;
+		// Header
+		std::getline(file, line);
+		while(std::getline(file, line)) {
+			std::istringstream row(line);
+			CampaignEntry entry;
+			std::string seed, lb_period, status;
+			std::getline(row, entry.name, ',');
+			std::getline(row, entry.config_hash, ',');
+			std::getline(row, seed, ',');
+			std::getline(row, entry.algorithm, ',');
+			std::getline(row, lb_period, ',');
+			std::getline(row, status, ',');
+			if(status.empty())
+				// Ignores malformed rows
+				continue;
+			entry.seed = std::stoul(seed);
+			entry.lb_period = std::stoul(lb_period);
+			entry.status = status == "COMPLETE" ?
+				RunStatus::COMPLETE : RunStatus::RUNNING;
+			entries.push_back(entry);
+		}
+	}
+
+bool CampaignManifest::complete(const CampaignEntry& entry) const {
+	for(auto& run : entries)
+		if(run.name == entry.name)
+			return run.status == RunStatus::COMPLETE
+				&& run.config_hash == entry.config_hash
+				&& run.seed == entry.seed;
+	return false;
+}
+
+bool CampaignManifest::running(const CampaignEntry& entry) const {
+	for(auto& run : entries)
+		if(run.name == entry.name)
+			return run.status == RunStatus::RUNNING
+				&& run.config_hash == entry.config_hash
+				&& run.seed == entry.seed;
+	return false;
+}
+
+const CampaignEntry* CampaignManifest::completeRun(
+		const std::string& config_hash, unsigned long seed) const {
+	for(auto& run : entries)
+		if(run.status == RunStatus::COMPLETE
+				&& run.config_hash == config_hash && run.seed == seed)
+			return &run;
+	return nullptr;
+}
+
+void CampaignManifest::update(const CampaignEntry& entry) {
+	bool found = false;
+	for(auto& run : entries)
+		if(run.name == entry.name) {
+			run = entry;
+			found = true;
+		}
+	if(!found)
+		entries.push_back(entry);
+
+	std::string tmp_filename = filename + ".tmp";
+	{
+		std::ofstream file(tmp_filename);
+		file << "NAME,CONFIG_HASH,SEED,LB_ALGORITHM,LB_PERIOD,STATUS"
+			<< std::endl;
+		for(auto& run : entries)
+			file << run.name << "," << run.config_hash << "," << run.seed << ","
+				<< run.algorithm << "," << run.lb_period << ","
+				<< (run.status == RunStatus::COMPLETE ? "COMPLETE" : "RUNNING")
+				<< std::endl;
+	}
+	std::rename(tmp_filename.c_str(), filename.c_str());
+}
+
+void commit_outputs(std::string name, int rank) {
+	for(std::string output : {
+			name + "." + std::to_string(rank) + ".csv",
+			name + ".warmup." + std::to_string(rank) + ".csv"
+			}) {
+		std::string part = output + ".part";
+		if(std::ifstream(part).good())
+			std::rename(part.c_str(), output.c_str());
+	}
+}
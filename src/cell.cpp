@@ -1,7 +1,73 @@
 #include "cell.h"
 #include "fpmas/api/model/spatial/spatial_model.h"
+#include "fpmas/communication/communication.h"
+#include <algorithm>
+#include <limits>
+#include <set>
 
 float MetaCell::cell_edge_weight = 1.0f;
+CellKernel MetaCell::cell_kernel = CellKernel::NONE;
+std::size_t MetaCell::interaction_range = 1;
+std::size_t MetaCell::lb_epoch = 0;
+float MetaCell::congestion = 0.f;
+
+MetaCell& MetaCell::operator=(const MetaCell& other) {
+	utility = other.utility;
+	data = other.data;
+	workload = other.workload;
+	agent_count = other.agent_count;
+	return *this;
+}
+
+MetaCell& MetaCell::operator=(MetaCell&& other) {
+	utility = other.utility;
+	data = std::move(other.data);
+	workload = other.workload;
+	agent_count = other.agent_count;
+	return *this;
+}
+
+void MetaCell::updateAgentCount() {
+	agent_count = this->cellNode()->getIncomingEdges(
+			fpmas::api::model::LOCATION).size();
+}
+
+void MetaCell::kernelInteraction(
+		const std::function<void(const InteractionCallbacks&)>& interaction) {
+	// Scratch buffer, reused by all cells executed by the current thread
+	static thread_local std::vector<std::uint32_t> sums;
+	sums.assign(data.size(), 0);
+	std::size_t read_count = 0;
+	interaction({
+			[&read_count] (const fpmas::api::model::Agent* neighbor) {
+				cell_kernel_accumulate(
+						cell_kernel, sums,
+						dynamic_cast<const MetaCell*>(neighbor)->data);
+				read_count++;
+			},
+			[this] (fpmas::api::model::Agent* neighbor) {
+				cell_kernel_write(
+						cell_kernel, dynamic_cast<MetaCell*>(neighbor)->data,
+						this->data);
+			}
+			});
+	if(read_count > 0) {
+		cell_kernel_update(cell_kernel, data, sums, read_count, next);
+		next_base.assign(data.begin(), data.end());
+		next_ready = true;
+	}
+}
+
+void MetaCell::commitState() {
+	if(next_ready) {
+		// Neighbors might have written the cell since its next state was
+		// computed
+		if(data != next_base)
+			cell_kernel_merge(cell_kernel, next_base, data, next);
+		data.swap(next);
+		next_ready = false;
+	}
+}
 
 void MetaCell::update_edge_weights() {
 	std::size_t agent_count
@@ -10,38 +76,58 @@ void MetaCell::update_edge_weights() {
 		edge->setWeight(cell_edge_weight + agent_count);
 };
 
-float UniformUtility::utility(GridAttractor, DiscretePoint) const {
+float UtilityFunction::utility(GridAttractor attractor, DiscretePoint point) const {
+	return utility(
+			attractor,
+			fpmas::api::model::euclidian_distance(attractor.center, point)
+			);
+}
+
+float UtilityFunction::support(Attractor) const {
+	return std::numeric_limits<float>::infinity();
+}
+
+float UniformUtility::utility(Attractor, float) const {
 	return 1.f;
 }
 
-float LinearUtility::utility(GridAttractor attractor, DiscretePoint point) const {
-	return std::max(
-			0.f, 1.0f - fpmas::api::model::euclidian_distance(
-				attractor.center, point
-				) / attractor.radius
-			);
+float LinearUtility::utility(Attractor attractor, float distance) const {
+	return std::max(0.f, 1.0f - distance / attractor.radius);
+}
+
+float LinearUtility::support(Attractor attractor) const {
+	return attractor.radius;
 }
 
-float InverseUtility::utility(GridAttractor attractor, DiscretePoint point) const {
+float InverseUtility::utility(Attractor attractor, float distance) const {
 	// 1/x like utility function depending on the distance from the center.
 	// Utility=1 at center
 	// Utility=beta when distance=radius
 	float beta = 0.5;
 	float alpha = (1 - beta) / (beta * attractor.radius);
-	return 1 / (1 + alpha * (fpmas::api::model::euclidian_distance(
-				attractor.center, point
-				)-offset));
+	return 1 / (1 + alpha * (distance-offset));
 }
 
-float StepUtility::utility(GridAttractor attractor, DiscretePoint point) const {
-	if(fpmas::api::model::euclidian_distance(
-			attractor.center, point
-			) > attractor.radius)
-		return InverseUtility(attractor.radius).utility(attractor, point);
+float StepUtility::utility(Attractor attractor, float distance) const {
+	if(distance > attractor.radius)
+		return InverseUtility(attractor.radius).utility(attractor, distance);
 	else
 		return 1000.f;
 }
 
+std::unique_ptr<UtilityFunction> make_utility_function(Utility utility) {
+	switch(utility) {
+		case Utility::LINEAR:
+			return std::unique_ptr<UtilityFunction>(new LinearUtility);
+		case Utility::INVERSE:
+			return std::unique_ptr<UtilityFunction>(new InverseUtility);
+		case Utility::STEP:
+			return std::unique_ptr<UtilityFunction>(new StepUtility);
+		default:
+			return std::unique_ptr<UtilityFunction>(new UniformUtility);
+	}
+}
+
 MetaGridCell* MetaGridCellFactory::build(fpmas::model::DiscretePoint location) {
 	float utility = 0;
 	for(auto attractor : attractors) {
@@ -54,4 +140,140 @@ MetaGraphCell* MetaGraphCellFactory::operator()() {
 	return new MetaGraphCell(1.0f, cell_size);
 }
 
+/**
+ * Computes the hop distance from each local cell to the cell with the
+ * specified global index.
+ *
+ * @param local_cells Local cells, sorted by DistributedId
+ * @param offset Global index of the first local cell
+ */
+static std::unordered_map<fpmas::api::graph::DistributedId, float> hop_distances(
+		const std::vector<fpmas::api::model::AgentNode*>& local_cells,
+		std::size_t offset, std::size_t cell_index,
+		fpmas::api::communication::MpiCommunicator& comm) {
+	std::unordered_map<fpmas::api::graph::DistributedId, fpmas::api::model::AgentNode*>
+		nodes;
+	for(auto node : local_cells)
+		nodes[node->getId()] = node;
+
+	std::unordered_map<fpmas::api::graph::DistributedId, float> distances;
+	std::vector<fpmas::api::model::AgentNode*> frontier;
+	if(cell_index >= offset && cell_index < offset + local_cells.size()) {
+		auto center = local_cells[cell_index - offset];
+		distances[center->getId()] = 0;
+		frontier.push_back(center);
+	}
+
+	fpmas::communication::TypedMpi<fpmas::api::graph::DistributedId> id_mpi(comm);
+	fpmas::communication::TypedMpi<std::size_t> size_mpi(comm);
+	float distance = 0;
+	while(fpmas::communication::all_reduce(
+				size_mpi, frontier.size(), std::plus<std::size_t>()) > 0) {
+		distance++;
+		// Predecessors of the frontier are sent to the processes that own
+		// them
+		std::unordered_map<int, std::vector<fpmas::api::graph::DistributedId>>
+			predecessors;
+		for(auto node : frontier)
+			for(auto edge : node->getIncomingEdges(fpmas::api::model::CELL_SUCCESSOR))
+				predecessors[edge->getSourceNode()->location()]
+					.push_back(edge->getSourceNode()->getId());
+		predecessors = id_mpi.migrate(predecessors);
+
+		frontier.clear();
+		for(auto& list : predecessors)
+			for(auto id : list.second) {
+				auto node = nodes.find(id);
+				if(node != nodes.end() && distances.count(id) == 0) {
+					distances[id] = distance;
+					frontier.push_back(node->second);
+				}
+			}
+	}
+	return distances;
+}
 
+void set_graph_utilities(
+		fpmas::api::model::AgentGroup& cell_group,
+		const UtilityFunction& utility_function,
+		const std::vector<GraphAttractor>& attractors,
+		fpmas::api::communication::MpiCommunicator& comm) {
+	std::vector<fpmas::api::model::AgentNode*> local_cells;
+	for(auto cell : cell_group.localAgents())
+		local_cells.push_back(cell->node());
+	std::sort(local_cells.begin(), local_cells.end(),
+			[] (fpmas::api::model::AgentNode* n1, fpmas::api::model::AgentNode* n2) {
+			return n1->getId() < n2->getId();
+			});
+
+	// Global index of the first local cell
+	fpmas::communication::TypedMpi<std::size_t> size_mpi(comm);
+	std::vector<std::size_t> counts = fpmas::communication::all_gather(
+			size_mpi, local_cells.size());
+	std::size_t offset = 0;
+	for(int i = 0; i < comm.getRank(); i++)
+		offset += counts[i];
+
+	std::unordered_map<fpmas::api::graph::DistributedId, float> utilities;
+	for(auto& attractor : attractors) {
+		auto distances = hop_distances(
+				local_cells, offset, attractor.cell_index, comm);
+		for(auto node : local_cells) {
+			auto distance = distances.find(node->getId());
+			utilities[node->getId()] += utility_function.utility(
+					attractor, distance == distances.end() ?
+					std::numeric_limits<float>::infinity() : distance->second);
+		}
+	}
+	for(auto node : local_cells)
+		dynamic_cast<MetaCell*>(node->data().get())
+			->setUtility(utilities[node->getId()]);
+}
+
+void link_interaction_range(
+		fpmas::api::model::Model& model,
+		fpmas::api::model::AgentGroup& cell_group,
+		std::size_t range) {
+	for(auto cell : cell_group.localAgents())
+		for(auto edge : cell->node()->getOutgoingEdges(
+					fpmas::api::model::CELL_SUCCESSOR))
+			model.link(cell, edge->getTargetNode()->data().get(), CELL_INTERACTION)
+				->setWeight(MetaCell::cell_edge_weight);
+	model.graph().synchronize();
+
+	for(std::size_t round = 1; round < range; round++) {
+		// Sources of incoming edges are within round hops: they are linked
+		// to successors, within round+1 hops. All pairs are collected before
+		// linking, so that edges created in this round are not relayed again.
+		std::vector<std::pair<
+			fpmas::api::model::Agent*, fpmas::api::model::Agent*>> links;
+		for(auto cell : cell_group.localAgents()) {
+			auto sources = cell->node()->getIncomingEdges(CELL_INTERACTION);
+			auto successors = cell->node()->getOutgoingEdges(
+					fpmas::api::model::CELL_SUCCESSOR);
+			for(auto source : sources)
+				for(auto successor : successors)
+					if(source->getSourceNode() != successor->getTargetNode())
+						links.push_back({
+								source->getSourceNode()->data().get(),
+								successor->getTargetNode()->data().get()
+								});
+		}
+		for(auto link : links)
+			model.link(link.first, link.second, CELL_INTERACTION)
+				->setWeight(MetaCell::cell_edge_weight);
+		model.graph().synchronize();
+
+		// Relays produce duplicated edges, that are removed by their source
+		for(auto cell : cell_group.localAgents()) {
+			std::set<DistributedId> targets;
+			for(auto edge : cell->node()->getOutgoingEdges(CELL_INTERACTION)) {
+				DistributedId target = edge->getTargetNode()->getId();
+				if(target == cell->node()->getId()
+						|| !targets.insert(target).second)
+					model.graph().unlink(edge);
+			}
+		}
+		model.graph().synchronize();
+	}
+}
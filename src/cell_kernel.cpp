@@ -0,0 +1,112 @@
+#include "cell_kernel.h"
+#include <algorithm>
+
+void cell_kernel_accumulate(
+		CellKernel kernel, std::vector<std::uint32_t>& sums,
+		const std::vector<char>& neighbor_data) {
+	std::size_t size = std::min(sums.size(), neighbor_data.size());
+	const unsigned char* neighbor
+		= reinterpret_cast<const unsigned char*>(neighbor_data.data());
+	std::uint32_t* sum = sums.data();
+	switch(kernel) {
+		case CellKernel::DIFFUSION:
+			for(std::size_t i = 0; i < size; i++)
+				sum[i] += neighbor[i];
+			break;
+		case CellKernel::GAME_OF_LIFE:
+			for(std::size_t i = 0; i < size; i++)
+				sum[i] += neighbor[i] & 1u;
+			break;
+		default:
+			break;
+	}
+}
+
+void cell_kernel_update(
+		CellKernel kernel, const std::vector<char>& data,
+		const std::vector<std::uint32_t>& sums, std::size_t count,
+		std::vector<char>& next) {
+	next.resize(data.size());
+	std::size_t size = std::min(data.size(), sums.size());
+	const unsigned char* state
+		= reinterpret_cast<const unsigned char*>(data.data());
+	unsigned char* next_state = reinterpret_cast<unsigned char*>(next.data());
+	const std::uint32_t* sum = sums.data();
+	switch(kernel) {
+		case CellKernel::DIFFUSION:
+			{
+				std::uint32_t n = count + 1;
+				for(std::size_t i = 0; i < size; i++)
+					next_state[i] = (state[i] + sum[i]) / n;
+			}
+			break;
+		case CellKernel::GAME_OF_LIFE:
+			for(std::size_t i = 0; i < size; i++)
+				next_state[i] = (sum[i] == 3) | ((state[i] & 1u) & (sum[i] == 2));
+			break;
+		default:
+			std::copy_n(state, size, next_state);
+			break;
+	}
+	// Bytes without contributions are left unchanged
+	std::copy(state + size, state + data.size(), next_state + size);
+}
+
+void cell_kernel_write(
+		CellKernel kernel, std::vector<char>& neighbor_data,
+		const std::vector<char>& data) {
+	std::size_t size = std::min(neighbor_data.size(), data.size());
+	unsigned char* neighbor
+		= reinterpret_cast<unsigned char*>(neighbor_data.data());
+	const unsigned char* state
+		= reinterpret_cast<const unsigned char*>(data.data());
+	switch(kernel) {
+		case CellKernel::DIFFUSION:
+			for(std::size_t i = 0; i < size; i++)
+				neighbor[i] = (neighbor[i] + state[i] + 1u) / 2;
+			break;
+		case CellKernel::GAME_OF_LIFE:
+			for(std::size_t i = 0; i < size; i++)
+				neighbor[i] |= state[i] & 1u;
+			break;
+		default:
+			break;
+	}
+}
+
+void cell_kernel_merge(
+		CellKernel kernel, const std::vector<char>& base,
+		const std::vector<char>& data, std::vector<char>& next) {
+	std::size_t size = std::min({base.size(), data.size(), next.size()});
+	const unsigned char* base_state
+		= reinterpret_cast<const unsigned char*>(base.data());
+	const unsigned char* state
+		= reinterpret_cast<const unsigned char*>(data.data());
+	unsigned char* next_state = reinterpret_cast<unsigned char*>(next.data());
+	switch(kernel) {
+		case CellKernel::DIFFUSION:
+			for(std::size_t i = 0; i < size; i++)
+				next_state[i] = std::min(255, std::max(0,
+							next_state[i] + state[i] - base_state[i]));
+			break;
+		case CellKernel::GAME_OF_LIFE:
+			for(std::size_t i = 0; i < size; i++)
+				next_state[i] |= state[i] & ~base_state[i] & 1u;
+			break;
+		default:
+			break;
+	}
+}
+
+void cell_kernel_init(std::vector<char>& data, std::uint64_t seed) {
+	// SplitMix64, that is much faster than drawing each byte from a
+	// distribution for large payloads
+	for(std::size_t i = 0; i < data.size(); i += 8) {
+		std::uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		z = z ^ (z >> 31);
+		for(std::size_t j = 0; j < 8 && i + j < data.size(); j++)
+			data[i+j] = (char) (z >> (8*j));
+	}
+}
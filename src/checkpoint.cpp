@@ -0,0 +1,140 @@
+#include "checkpoint.h"
+#include "fpmas/io/breakpoint.h"
+#include "fpmas/model/serializer.h"
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+
+fpmas::scheduler::TimeStep CheckpointState::restart_time_step() const {
+	return ((fpmas::scheduler::TimeStep) date) + 1;
+}
+
+Checkpoint::Checkpoint(
+		std::string name,
+		fpmas::api::communication::MpiCommunicator& comm) :
+	comm(comm),
+	filename(name + ".checkpoint." + std::to_string(comm.getRank()) + ".bin"),
+	csv_filename(name + "." + std::to_string(comm.getRank()) + ".csv.part") {
+	}
+
+bool Checkpoint::exists() const {
+	int missing = std::ifstream(filename).good() ? 0 : 1;
+	fpmas::communication::TypedMpi<int> int_mpi(comm);
+	return fpmas::communication::all_reduce(
+			int_mpi, missing, std::plus<int>()
+			) == 0;
+}
+
+void Checkpoint::dump(
+		const fpmas::api::model::Model& model,
+		const CheckpointState& state) const {
+	// The previous checkpoint is only replaced once the new one is complete
+	std::string tmp_filename = filename + ".tmp";
+	{
+		std::ofstream file(tmp_filename, std::ios::binary);
+		fpmas::io::DatapackBreakpoint<CheckpointState> state_breakpoint;
+		state_breakpoint.dump(file, state);
+		fpmas::io::DatapackBreakpoint<fpmas::api::model::Model> model_breakpoint;
+		model_breakpoint.dump(file, model);
+	}
+	std::rename(tmp_filename.c_str(), filename.c_str());
+}
+
+CheckpointState Checkpoint::load(fpmas::api::model::Model& model) const {
+	std::ifstream file(filename, std::ios::binary);
+	CheckpointState state;
+	fpmas::io::DatapackBreakpoint<CheckpointState> state_breakpoint;
+	state_breakpoint.load(file, state);
+	fpmas::io::DatapackBreakpoint<fpmas::api::model::Model> model_breakpoint;
+	model_breakpoint.load(file, model);
+	return state;
+}
+
+CheckpointState Checkpoint::loadState() const {
+	std::ifstream file(filename, std::ios::binary);
+	CheckpointState state;
+	fpmas::io::DatapackBreakpoint<CheckpointState> state_breakpoint;
+	state_breakpoint.load(file, state);
+	return state;
+}
+
+void Checkpoint::backupCsv() const {
+	CheckpointState state = loadState();
+	std::string prefix_filename = csv_filename + ".restart";
+	std::string tmp_filename = prefix_filename + ".tmp";
+	{
+		std::ifstream csv(csv_filename, std::ios::binary);
+		std::vector<char> rows(state.csv_offset);
+		csv.read(rows.data(), rows.size());
+		rows.resize(csv.gcount());
+
+		std::ofstream prefix(tmp_filename, std::ios::binary);
+		auto begin = rows.begin();
+		std::ifstream previous_prefix(prefix_filename, std::ios::binary);
+		if(previous_prefix.good()) {
+			// The run was already restarted: the CSV output only contains
+			// rows written since the previous restart, following the header
+			// already included in the previous prefix.
+			prefix << previous_prefix.rdbuf();
+			begin = std::find(rows.begin(), rows.end(), '\n');
+			if(begin != rows.end())
+				begin++;
+		}
+		prefix.write(rows.data() + (begin - rows.begin()), rows.end() - begin);
+	}
+	std::rename(tmp_filename.c_str(), prefix_filename.c_str());
+}
+
+void Checkpoint::mergeCsv() const {
+	std::string prefix_filename = csv_filename + ".restart";
+	std::string merged_filename = csv_filename + ".merge";
+	{
+		std::ifstream prefix(prefix_filename, std::ios::binary);
+		std::ifstream restarted(csv_filename, std::ios::binary);
+		std::ofstream merged(merged_filename, std::ios::binary);
+
+		// Header and rows written before the last checkpoint
+		merged << prefix.rdbuf();
+		// Rows written by the restarted run, without the header
+		std::string header;
+		std::getline(restarted, header);
+		if(restarted.peek() != std::ifstream::traits_type::eof())
+			merged << restarted.rdbuf();
+	}
+	std::rename(merged_filename.c_str(), csv_filename.c_str());
+	std::remove(prefix_filename.c_str());
+}
+
+void Checkpoint::clear() const {
+	std::remove(filename.c_str());
+	std::remove((csv_filename + ".restart").c_str());
+}
+
+namespace fpmas { namespace io { namespace datapack {
+	std::size_t Serializer<CheckpointState>::size(
+			const ObjectPack& pack, const CheckpointState& state) {
+		return pack.size(state.date) + pack.size(state.csv_offset)
+			+ pack.size(state.random_interactions)
+			+ pack.size(state.random_neighbors);
+	}
+
+	void Serializer<CheckpointState>::to_datapack(
+			ObjectPack& pack, const CheckpointState& state) {
+		pack.put(state.date);
+		pack.put(state.csv_offset);
+		pack.put(state.random_interactions);
+		pack.put(state.random_neighbors);
+	}
+
+	CheckpointState Serializer<CheckpointState>::from_datapack(
+			const ObjectPack& pack) {
+		CheckpointState state;
+		state.date = pack.get<fpmas::scheduler::Date>();
+		state.csv_offset = pack.get<std::size_t>();
+		state.random_interactions
+			= pack.get<fpmas::random::DistributedGenerator<>>();
+		state.random_neighbors
+			= pack.get<fpmas::random::DistributedGenerator<>>();
+		return state;
+	}
+}}}
@@ -1,5 +1,10 @@
 #include "agent.h"
 #include "config.h"
+#include <cmath>
+#include <tuple>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
 
 #define LOAD_YAML_CONFIG_0(FIELD_NAME, TYPENAME)\
 	load_config(#FIELD_NAME, FIELD_NAME, config[#FIELD_NAME], #TYPENAME)
@@ -13,16 +18,21 @@
 
 GraphConfig::GraphConfig(YAML::Node config) {
 	LOAD_YAML_CONFIG_0(environment, Environment);
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			cells_per_process, std::size_t, (std::size_t) 0);
 	switch(this->environment) {
 		case Environment::GRID:
-			LOAD_YAML_CONFIG_0(grid_width, unsigned int);
-			LOAD_YAML_CONFIG_0(grid_height, unsigned int);
+			if(this->cells_per_process == 0) {
+				LOAD_YAML_CONFIG_0(grid_width, unsigned int);
+				LOAD_YAML_CONFIG_0(grid_height, unsigned int);
+			}
 			break;
 		case Environment::SMALL_WORLD:
 			LOAD_YAML_CONFIG_0(p, float);
 		case Environment::CLUSTERED:
 		case Environment::RANDOM:
-			LOAD_YAML_CONFIG_0(num_cells, unsigned int);
+			if(this->cells_per_process == 0)
+				LOAD_YAML_CONFIG_0(num_cells, unsigned int);
 			LOAD_YAML_CONFIG_0(output_degree, unsigned int);
 	}
 	LOAD_YAML_CONFIG_0_OPTIONAL(cell_weight, float, 1.0f);
@@ -34,13 +44,145 @@ GraphConfig::GraphConfig(YAML::Node config) {
 				LOAD_YAML_CONFIG_0(grid_attractors, std::vector<GridAttractor>);
 				break;
 			default:
-				break;
-				// TODO: Graph based attractors
+				LOAD_YAML_CONFIG_0_OPTIONAL(
+						graph_attractors, std::vector<GraphAttractor>,
+						std::vector<GraphAttractor>());
 		}
 	LOAD_YAML_CONFIG_0_OPTIONAL(zoltan_imbalance_tol, float, 1.1f);
 	LOAD_YAML_CONFIG_0_OPTIONAL(json_output, bool, false);
 	LOAD_YAML_CONFIG_0_OPTIONAL(json_output_period, int, -1);
 	LOAD_YAML_CONFIG_0_OPTIONAL(dot_output, bool, false);
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			environment_snapshot, std::string, std::string());
+}
+
+void GraphConfig::applyWeakScaling(int process_count) {
+	if(this->cells_per_process == 0)
+		return;
+	std::size_t cell_count = this->cells_per_process * process_count;
+	switch(this->environment) {
+		case Environment::GRID:
+			std::tie(this->grid_width, this->grid_height)
+				= near_square_grid(cell_count);
+			break;
+		default:
+			this->num_cells = cell_count;
+	}
+}
+
+void GraphConfig::validate() {
+	if(this->environment != Environment::GRID)
+		for(auto& attractor : this->graph_attractors)
+			if(attractor.cell_index >= this->num_cells) {
+				std::cerr << "[FATAL ERROR] graph_attractors cell indexes must "
+					"be lower than the count of cells (" << this->num_cells
+					<< ")" << std::endl;
+				this->is_valid = false;
+				break;
+			}
+}
+
+std::pair<std::size_t, std::size_t> near_square_grid(std::size_t cell_count) {
+	std::size_t height = (std::size_t) std::sqrt(cell_count);
+	// Largest divisor of cell_count lower than or equal to sqrt(cell_count)
+	while(height > 1 && cell_count % height != 0)
+		height--;
+	if(height > 0 && cell_count / height <= 2 * height)
+		return {cell_count / height, height};
+
+	std::size_t width = (std::size_t) std::ceil(std::sqrt(cell_count));
+	return {width, (cell_count + width - 1) / width};
+}
+
+bool GridAttractor::isDynamic() const {
+	return velocity_x != 0 || velocity_y != 0
+		|| (speed > 0 && !waypoints.empty()) || on_period > 0;
+}
+
+bool GridAttractor::isActive(fpmas::api::scheduler::TimeStep time_step) const {
+	if(on_period == 0)
+		return true;
+	return time_step % (on_period + off_period) < on_period;
+}
+
+/**
+ * Returns true iff the interactions perform writes on neighbors.
+ */
+static bool writes(Interactions interactions) {
+	switch(interactions) {
+		case Interactions::WRITE_ALL:
+		case Interactions::WRITE_ONE:
+		case Interactions::READ_ALL_WRITE_ONE:
+		case Interactions::READ_ALL_WRITE_ALL:
+		case Interactions::WRITE_K:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * Position at distance `position` of 0 along an axis of size `size`, bouncing
+ * on 0 and `size-1`.
+ */
+static float bounce(float position, std::size_t size) {
+	if(size <= 1)
+		return 0;
+	float length = 2 * (float) (size-1);
+	position = std::fmod(position, length);
+	if(position < 0)
+		position += length;
+	return position > size-1 ? length - position : position;
+}
+
+fpmas::api::model::DiscretePoint GridAttractor::centerAt(
+		fpmas::api::scheduler::TimeStep time_step,
+		std::size_t grid_width, std::size_t grid_height) const {
+	float x = center.x;
+	float y = center.y;
+	if(speed > 0 && !waypoints.empty()) {
+		// Closed path from the initial center
+		std::vector<fpmas::api::model::DiscretePoint> path {center};
+		path.insert(path.end(), waypoints.begin(), waypoints.end());
+		float length = 0;
+		for(std::size_t i = 0; i < path.size(); i++)
+			length += fpmas::api::model::euclidian_distance(
+					path[i], path[(i+1) % path.size()]);
+		if(length > 0) {
+			float distance = std::fmod(speed * time_step, length);
+			for(std::size_t i = 0; i < path.size(); i++) {
+				auto& begin = path[i];
+				auto& end = path[(i+1) % path.size()];
+				float segment = fpmas::api::model::euclidian_distance(begin, end);
+				if(distance <= segment && segment > 0) {
+					x = begin.x + (end.x - begin.x) * distance / segment;
+					y = begin.y + (end.y - begin.y) * distance / segment;
+					break;
+				}
+				distance -= segment;
+			}
+		}
+	}
+	x = bounce(x + velocity_x * time_step, grid_width);
+	y = bounce(y + velocity_y * time_step, grid_height);
+	return {
+		(fpmas::api::model::DiscreteCoordinate) std::round(x),
+		(fpmas::api::model::DiscreteCoordinate) std::round(y)
+	};
+}
+
+std::string config_hash(const YAML::Node& node) {
+	YAML::Emitter emitter;
+	emitter << node;
+
+	std::uint64_t hash = 14695981039346656037ull;
+	for(const char* c = emitter.c_str(); *c != '\0'; c++) {
+		hash ^= (unsigned char) *c;
+		hash *= 1099511628211ull;
+	}
+	std::ostringstream key;
+	key << std::hex << std::setfill('0') << std::setw(16) << hash;
+	return key.str();
 }
 
 ModelConfig::ModelConfig(const GraphConfig& graph_config)
@@ -48,10 +190,31 @@ ModelConfig::ModelConfig(const GraphConfig& graph_config)
 	}
 
 ModelConfig::ModelConfig(YAML::Node config) : GraphConfig(config) {
-	LOAD_YAML_CONFIG_0(occupation_rate, float);
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			agents_per_process, std::size_t, (std::size_t) 0);
+	if(this->agents_per_process == 0)
+		LOAD_YAML_CONFIG_0(occupation_rate, float);
+	else
+		// Set by applyWeakScaling()
+		this->occupation_rate = 0.0;
 	LOAD_YAML_CONFIG_0(num_steps, fpmas::api::scheduler::TimeStep);
-	if(this->occupation_rate > 0.0) {
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			warmup_steps, fpmas::api::scheduler::TimeStep,
+			(fpmas::api::scheduler::TimeStep) 0);
+	if(this->warmup_steps > 0 && this->warmup_steps >= this->num_steps) {
+		std::cerr << "[FATAL ERROR] warmup_steps must be lower than "
+			"num_steps" << std::endl;
+		this->is_valid = false;
+	}
+	// Static field, that might have been set by a previous configuration
+	MetaAgentBase::contact_interactions = Interactions::NONE;
+	if(this->occupation_rate > 0.0 || this->agents_per_process > 0) {
 		LOAD_YAML_CONFIG_0_OPTIONAL(agent_weight, float, 1.0f);
+		LOAD_YAML_CONFIG_0_OPTIONAL(agent_workload, Workload, Workload());
+		LOAD_YAML_CONFIG_0_OPTIONAL(spawn_rate, float, 0.f);
+		LOAD_YAML_CONFIG_0_OPTIONAL(
+				lifespan, fpmas::api::scheduler::TimeStep,
+				(fpmas::api::scheduler::TimeStep) 0);
 		LOAD_YAML_CONFIG_0_OPTIONAL(
 				agent_interactions, AgentInteractions, AgentInteractions::LOCAL
 				);
@@ -60,17 +223,188 @@ ModelConfig::ModelConfig(YAML::Node config) : GraphConfig(config) {
 			LOAD_YAML_CONFIG_0(refresh_distant_contacts, fpmas::api::scheduler::TimeStep);
 			LOAD_YAML_CONFIG_1_OPTIONAL(MetaAgentBase, contact_weight, float, 1.0f);
 			LOAD_YAML_CONFIG_1(MetaAgentBase, max_contacts, unsigned int);
+			LOAD_YAML_CONFIG_1_OPTIONAL(
+					MetaAgentBase, contact_interactions, Interactions,
+					Interactions::NONE);
+			if(MetaAgentBase::contact_interactions != Interactions::NONE) {
+				LOAD_YAML_CONFIG_1_OPTIONAL(
+						MetaAgentBase, infection_rate, float, 0.5f);
+				LOAD_YAML_CONFIG_1_OPTIONAL(
+						MetaAgentBase, recovery_rate, float, 0.1f);
+				LOAD_YAML_CONFIG_1_OPTIONAL(
+						MetaAgentBase, initial_infected, float, 0.01f);
+				for(float rate : {
+						MetaAgentBase::infection_rate,
+						MetaAgentBase::recovery_rate,
+						MetaAgentBase::initial_infected})
+					if(rate < 0 || rate > 1) {
+						std::cerr << "[FATAL ERROR] MetaAgentBase::infection_rate, "
+							"recovery_rate and initial_infected must be in "
+							"[0, 1]" << std::endl;
+						this->is_valid = false;
+						break;
+					}
+			}
 		}
 	}
-	LOAD_YAML_CONFIG_0_OPTIONAL(cell_interactions, Interactions, Interactions::NONE);
+	YAML::Node cell_interactions_node = config["cell_interactions"];
+	if(cell_interactions_node.IsMap() && cell_interactions_node.size() == 1) {
+		// Parameterized interactions, e.g. {READ_K: {k: 3, p: 0.2}}
+		auto interactions = cell_interactions_node.begin();
+		load_config(
+				"cell_interactions", this->cell_interactions,
+				interactions->first, "Interactions");
+		load_config_optional(
+				"cell_interactions::k", ReaderWriter::k,
+				interactions->second["k"], "std::size_t", (std::size_t) 1);
+		load_config_optional(
+				"cell_interactions::p", ReaderWriter::p,
+				interactions->second["p"], "float", 1.f);
+	} else {
+		LOAD_YAML_CONFIG_0_OPTIONAL(cell_interactions, Interactions, Interactions::NONE);
+		ReaderWriter::k = 1;
+		ReaderWriter::p = 1.f;
+	}
+	if(ReaderWriter::k == 0 || ReaderWriter::p < 0 || ReaderWriter::p > 1) {
+		std::cerr << "[FATAL ERROR] cell_interactions k must be positive and "
+			"p must be in [0, 1]" << std::endl;
+		this->is_valid = false;
+	}
+	LOAD_YAML_CONFIG_1_OPTIONAL(MetaCell, cell_kernel, CellKernel, CellKernel::NONE);
+	LOAD_YAML_CONFIG_1_OPTIONAL(
+			MetaCell, interaction_range, std::size_t, (std::size_t) 1);
+	LOAD_YAML_CONFIG_1_OPTIONAL(MetaCell, congestion, float, 0.f);
+	if(MetaCell::interaction_range == 0) {
+		std::cerr << "[FATAL ERROR] MetaCell::interaction_range must be "
+			"positive" << std::endl;
+		this->is_valid = false;
+	}
 	LOAD_YAML_CONFIG_0_OPTIONAL(dynamic_cell_edge_weights, bool, false);
+	LOAD_YAML_CONFIG_0_OPTIONAL(dynamic_cell_weights, bool, false);
+	LOAD_YAML_CONFIG_0_OPTIONAL(auto_weights, bool, false);
+	if(this->auto_weights) {
+		LOAD_YAML_CONFIG_0_OPTIONAL(auto_weights_smoothing, float, 0.5f);
+		LOAD_YAML_CONFIG_0_OPTIONAL(auto_weights_communication_cost, float, 0.f);
+		if(this->auto_weights_smoothing <= 0 || this->auto_weights_smoothing > 1) {
+			std::cerr << "[FATAL ERROR] auto_weights_smoothing must be in "
+				"]0, 1]" << std::endl;
+			this->is_valid = false;
+		}
+	}
 	LOAD_YAML_CONFIG_0_OPTIONAL(sync_mode, SyncMode, SyncMode::GHOST_MODE);
+	// In ghost modes, writes only modify the ghost copy of DISTANT
+	// neighbors, and are overwritten at the next synchronization
+	if(this->sync_mode != SyncMode::HARD_SYNC_MODE) {
+		if(writes(MetaAgentBase::contact_interactions)) {
+			std::cerr << "[FATAL ERROR] MetaAgentBase::contact_interactions "
+				"with writes require the HARD_SYNC_MODE sync_mode"
+				<< std::endl;
+			this->is_valid = false;
+		}
+		if(MetaCell::cell_kernel != CellKernel::NONE
+				&& writes(this->cell_interactions)) {
+			std::cerr << "[FATAL ERROR] MetaCell::cell_kernel with "
+				"cell_interactions with writes requires the HARD_SYNC_MODE "
+				"sync_mode" << std::endl;
+			this->is_valid = false;
+		}
+	}
+	LOAD_YAML_CONFIG_0_OPTIONAL(num_threads, unsigned int, 1u);
 	LOAD_YAML_CONFIG_0_OPTIONAL(cell_size, std::size_t, (std::size_t) 0);
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			cell_size_distribution, CellSizeDistribution,
+			CellSizeDistribution::CONSTANT);
+	if(this->cell_size_distribution == CellSizeDistribution::LOGNORMAL)
+		LOAD_YAML_CONFIG_0_OPTIONAL(cell_size_sigma, float, 1.f);
+	LOAD_YAML_CONFIG_0_OPTIONAL(cell_workload, Workload, Workload());
 	LOAD_YAML_CONFIG_1_OPTIONAL(
 			MetaAgentBase, move_policy, MovePolicy, MovePolicy::RANDOM);
 	LOAD_YAML_CONFIG_1_OPTIONAL(
 			MetaAgentBase, range_size, unsigned int, (std::size_t) 1);
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			checkpoint_period, fpmas::api::scheduler::TimeStep,
+			(fpmas::api::scheduler::TimeStep) 0);
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			autotune_steps, fpmas::api::scheduler::TimeStep,
+			(fpmas::api::scheduler::TimeStep) 10);
+	LOAD_YAML_CONFIG_0_OPTIONAL(
+			autotune_imbalance_tol, std::vector<float>,
+			std::vector<float>({1.01f, 1.5f}));
+	if(this->autotune_imbalance_tol.size() != 2) {
+		std::cerr << "[FATAL ERROR] autotune_imbalance_tol must be specified as "
+			"[min, max]" << std::endl;
+		this->is_valid = false;
+	}
+	LOAD_YAML_CONFIG_0_OPTIONAL(autotune_iterations, unsigned int, 5u);
+	loadSpecies(config["species"]);
 	LOAD_YAML_CONFIG_0(test_cases, std::vector<TestCaseConfig>);
+	if(config["test_cases"].IsSequence() && this->test_cases.empty()) {
+		std::cerr << "[FATAL ERROR] test_cases must not be empty" << std::endl;
+		this->is_valid = false;
+	}
+	for(auto& test_case : this->test_cases)
+		if(test_case.lb_periods.empty()) {
+			std::cerr << "[FATAL ERROR] The lb_periods of the "
+				<< test_case.algorithm << " test case must not be empty"
+				<< std::endl;
+			this->is_valid = false;
+		}
+}
+
+void ModelConfig::loadSpecies(YAML::Node config) {
+	// Global agent configuration, used as default for all species
+	Species default_species;
+	default_species.name = "default";
+	default_species.range_size = MetaAgentBase::range_size;
+	default_species.move_policy = MetaAgentBase::move_policy;
+	default_species.weight = this->agent_weight;
+	default_species.max_contacts = MetaAgentBase::max_contacts;
+	default_species.contact_weight = MetaAgentBase::contact_weight;
+
+	this->species.clear();
+	if(!config.IsDefined()) {
+		this->species.push_back(default_species);
+	} else if(!config.IsSequence() || config.size() == 0
+			|| config.size() > MetaAgentBase::max_species) {
+		std::cerr << "[FATAL ERROR] species must be a list of 1 to "
+			<< MetaAgentBase::max_species << " species" << std::endl;
+		this->is_valid = false;
+	} else {
+		float total_fraction = 0;
+		for(auto node : config) {
+			Species species = default_species;
+			species.name = "species" + std::to_string(this->species.size());
+			bool valid;
+			try {
+				valid = YAML::convert<Species>::decode(node, species);
+			} catch(const YAML::Exception&) {
+				valid = false;
+			}
+			if(!valid) {
+				std::cerr << "[FATAL ERROR] Bad species field parsing. "
+					"Expected type: Species" << std::endl;
+				this->is_valid = false;
+			}
+			total_fraction += species.fraction;
+			this->species.push_back(species);
+		}
+		if(total_fraction <= 0) {
+			std::cerr << "[FATAL ERROR] The total fraction of species must be "
+				"positive" << std::endl;
+			this->is_valid = false;
+		}
+	}
+	MetaAgentBase::species_table = this->species;
+}
+
+void ModelConfig::applyWeakScaling(int process_count) {
+	GraphConfig::applyWeakScaling(process_count);
+	if(this->agents_per_process == 0)
+		return;
+	std::size_t cell_count = this->environment == Environment::GRID ?
+		this->grid_width * this->grid_height : this->num_cells;
+	this->occupation_rate
+		= (float) (this->agents_per_process * process_count) / cell_count;
 }
 
 namespace YAML {
@@ -170,54 +504,6 @@ namespace YAML {
 		return false;
 	}
 
-	Node convert<LbAlgorithm>::encode(const LbAlgorithm& lb_algorithm) {
-		switch(lb_algorithm) {
-			case LbAlgorithm::SCHEDULED_LB:
-				return Node("SCHEDULED_LB");
-			case LbAlgorithm::ZOLTAN_LB:
-				return Node("ZOLTAN_LB");
-			case LbAlgorithm::GRID_LB:
-				return Node("GRID_LB");
-			case LbAlgorithm::ZOLTAN_CELL_LB:
-				return Node("ZOLTAN_CELL_LB");
-			case LbAlgorithm::STATIC_ZOLTAN_CELL_LB:
-				return Node("STATIC_ZOLTAN_CELL_LB");
-			case LbAlgorithm::RANDOM_LB:
-				return Node("RANDOM_LB");
-			default:
-				return Node();
-		}
-	}
-
-	bool convert<LbAlgorithm>::decode(const Node &node, LbAlgorithm& lb_algorithm) {
-		std::string str = node.as<std::string>();
-		if(str == "SCHEDULED_LB") {
-			lb_algorithm = LbAlgorithm::SCHEDULED_LB;
-			return true;
-		}
-		if(str == "ZOLTAN_LB") {
-			lb_algorithm = LbAlgorithm::ZOLTAN_LB;
-			return true;
-		}
-		if(str == "GRID_LB") {
-			lb_algorithm = LbAlgorithm::GRID_LB;
-			return true;
-		}
-		if(str == "ZOLTAN_CELL_LB") {
-			lb_algorithm = LbAlgorithm::ZOLTAN_CELL_LB;
-			return true;
-		}
-		if(str == "STATIC_ZOLTAN_CELL_LB") {
-			lb_algorithm = LbAlgorithm::STATIC_ZOLTAN_CELL_LB;
-			return true;
-		}
-		if(str == "RANDOM_LB") {
-			lb_algorithm = LbAlgorithm::RANDOM_LB;
-			return true;
-		}
-		return false;
-	}
-
 	Node convert<AgentInteractions>::encode(
 			const AgentInteractions& agent_interactions) {
 		switch(agent_interactions) {
@@ -262,6 +548,10 @@ namespace YAML {
 				return Node("WRITE_ALL");
 			case Interactions::WRITE_ONE:
 				return Node("WRITE_ONE");
+			case Interactions::READ_K:
+				return Node("READ_K");
+			case Interactions::WRITE_K:
+				return Node("WRITE_K");
 			default:
 				return Node();
 		}
@@ -299,6 +589,14 @@ namespace YAML {
 			interactions = Interactions::WRITE_ONE;
 			return true;
 		}
+		if(str == "READ_K") {
+			interactions = Interactions::READ_K;
+			return true;
+		}
+		if(str == "WRITE_K") {
+			interactions = Interactions::WRITE_K;
+			return true;
+		}
 		return false;
 	}
 
@@ -335,6 +633,168 @@ namespace YAML {
 		return false;
 	}
 		
+	Node convert<WorkloadDistribution>::encode(
+			const WorkloadDistribution& distribution) {
+		switch(distribution) {
+			case WorkloadDistribution::CONSTANT:
+				return Node("CONSTANT");
+			case WorkloadDistribution::UNIFORM:
+				return Node("UNIFORM");
+			case WorkloadDistribution::PARETO:
+				return Node("PARETO");
+			case WorkloadDistribution::UTILITY:
+				return Node("UTILITY");
+			default:
+				return Node();
+		}
+	}
+
+	bool convert<WorkloadDistribution>::decode(
+			const Node &node, WorkloadDistribution& distribution) {
+		std::string str = node.as<std::string>();
+		if(str == "CONSTANT") {
+			distribution = WorkloadDistribution::CONSTANT;
+			return true;
+		}
+		if(str == "UNIFORM") {
+			distribution = WorkloadDistribution::UNIFORM;
+			return true;
+		}
+		if(str == "PARETO") {
+			distribution = WorkloadDistribution::PARETO;
+			return true;
+		}
+		if(str == "UTILITY") {
+			distribution = WorkloadDistribution::UTILITY;
+			return true;
+		}
+		return false;
+	}
+
+	Node convert<CellKernel>::encode(const CellKernel& kernel) {
+		switch(kernel) {
+			case CellKernel::NONE:
+				return Node("NONE");
+			case CellKernel::DIFFUSION:
+				return Node("DIFFUSION");
+			case CellKernel::GAME_OF_LIFE:
+				return Node("GAME_OF_LIFE");
+			default:
+				return Node();
+		}
+	}
+
+	bool convert<CellKernel>::decode(const Node &node, CellKernel& kernel) {
+		std::string str = node.as<std::string>();
+		if(str == "NONE") {
+			kernel = CellKernel::NONE;
+			return true;
+		}
+		if(str == "DIFFUSION") {
+			kernel = CellKernel::DIFFUSION;
+			return true;
+		}
+		if(str == "GAME_OF_LIFE") {
+			kernel = CellKernel::GAME_OF_LIFE;
+			return true;
+		}
+		return false;
+	}
+
+	Node convert<CellSizeDistribution>::encode(
+			const CellSizeDistribution& distribution) {
+		switch(distribution) {
+			case CellSizeDistribution::CONSTANT:
+				return Node("CONSTANT");
+			case CellSizeDistribution::UNIFORM:
+				return Node("UNIFORM");
+			case CellSizeDistribution::LOGNORMAL:
+				return Node("LOGNORMAL");
+			case CellSizeDistribution::UTILITY:
+				return Node("UTILITY");
+			default:
+				return Node();
+		}
+	}
+
+	bool convert<CellSizeDistribution>::decode(
+			const Node &node, CellSizeDistribution& distribution) {
+		std::string str = node.as<std::string>();
+		if(str == "CONSTANT") {
+			distribution = CellSizeDistribution::CONSTANT;
+			return true;
+		}
+		if(str == "UNIFORM") {
+			distribution = CellSizeDistribution::UNIFORM;
+			return true;
+		}
+		if(str == "LOGNORMAL") {
+			distribution = CellSizeDistribution::LOGNORMAL;
+			return true;
+		}
+		if(str == "UTILITY") {
+			distribution = CellSizeDistribution::UTILITY;
+			return true;
+		}
+		return false;
+	}
+
+	Node convert<Workload>::encode(const Workload& workload) {
+		Node node;
+		node["distribution"] = workload.distribution;
+		node["flops"] = workload.flops;
+		if(workload.distribution == WorkloadDistribution::PARETO)
+			node["alpha"] = workload.alpha;
+		return node;
+	}
+
+	bool convert<Workload>::decode(const Node &node, Workload& workload) {
+		if(!node.IsMap() || !node["flops"])
+			return false;
+		workload.flops = node["flops"].as<float>();
+		if(node["distribution"])
+			workload.distribution = node["distribution"].as<WorkloadDistribution>();
+		if(node["alpha"])
+			workload.alpha = node["alpha"].as<float>();
+		if(workload.distribution == WorkloadDistribution::PARETO
+				&& workload.alpha <= 1)
+			return false;
+		return true;
+	}
+
+	Node convert<Species>::encode(const Species& species) {
+		Node node;
+		node["name"] = species.name;
+		node["fraction"] = species.fraction;
+		node["range_size"] = species.range_size;
+		node["move_policy"] = species.move_policy;
+		node["weight"] = species.weight;
+		node["max_contacts"] = species.max_contacts;
+		node["contact_weight"] = species.contact_weight;
+		return node;
+	}
+
+	bool convert<Species>::decode(const Node &node, Species& species) {
+		// Unspecified fields are left unchanged
+		if(!node.IsMap())
+			return false;
+		if(node["name"])
+			species.name = node["name"].as<std::string>();
+		if(node["fraction"])
+			species.fraction = node["fraction"].as<float>();
+		if(node["range_size"])
+			species.range_size = node["range_size"].as<std::size_t>();
+		if(node["move_policy"])
+			species.move_policy = node["move_policy"].as<MovePolicy>();
+		if(node["weight"])
+			species.weight = node["weight"].as<float>();
+		if(node["max_contacts"])
+			species.max_contacts = node["max_contacts"].as<std::size_t>();
+		if(node["contact_weight"])
+			species.contact_weight = node["contact_weight"].as<float>();
+		return species.fraction >= 0 && species.range_size > 0;
+	}
+
 	Node convert<Attractor>::encode(const Attractor& attractor) {
 		Node node(attractor.radius);
 		return node;
@@ -354,26 +814,107 @@ namespace YAML {
 		point.push_back(attractor.center.y);
 
 		Node node;
-		node.push_back(point);
-		node.push_back(attractor.radius);
+		if(!attractor.isDynamic()) {
+			node.push_back(point);
+			node.push_back(attractor.radius);
+			return node;
+		}
+		node["center"] = point;
+		node["radius"] = attractor.radius;
+		if(attractor.velocity_x != 0 || attractor.velocity_y != 0) {
+			node["velocity"].push_back(attractor.velocity_x);
+			node["velocity"].push_back(attractor.velocity_y);
+		}
+		if(!attractor.waypoints.empty()) {
+			for(auto& waypoint : attractor.waypoints) {
+				Node waypoint_node;
+				waypoint_node.push_back(waypoint.x);
+				waypoint_node.push_back(waypoint.y);
+				node["waypoints"].push_back(waypoint_node);
+			}
+			node["speed"] = attractor.speed;
+		}
+		if(attractor.on_period > 0) {
+			node["period"].push_back(attractor.on_period);
+			node["period"].push_back(attractor.off_period);
+		}
 		return node;
 	}
 
+	static bool decode_point(const Node& node, fpmas::api::model::DiscretePoint& point) {
+		if(!node.IsSequence() || node.size() != 2)
+			return false;
+		point = {
+			node[0].as<fpmas::api::model::DiscreteCoordinate>(),
+			node[1].as<fpmas::api::model::DiscreteCoordinate>(),
+		};
+		return true;
+	}
+
 	bool convert<GridAttractor>::decode(const Node &node, GridAttractor& attractor) {
+		if(node.IsMap()) {
+			// Dynamic attractor
+			if(!node["center"] || !decode_point(node["center"], attractor.center))
+				return false;
+			if(!node["radius"] || !node["radius"].IsScalar())
+				return false;
+			attractor.radius = node["radius"].as<float>();
+			if(node["velocity"]) {
+				if(!node["velocity"].IsSequence() || node["velocity"].size() != 2)
+					return false;
+				attractor.velocity_x = node["velocity"][0].as<float>();
+				attractor.velocity_y = node["velocity"][1].as<float>();
+			}
+			if(node["waypoints"]) {
+				if(!node["waypoints"].IsSequence() || !node["speed"])
+					return false;
+				for(auto waypoint : node["waypoints"]) {
+					fpmas::api::model::DiscretePoint point;
+					if(!decode_point(waypoint, point))
+						return false;
+					attractor.waypoints.push_back(point);
+				}
+				attractor.speed = node["speed"].as<float>();
+			}
+			if(node["period"]) {
+				if(!node["period"].IsSequence() || node["period"].size() != 2)
+					return false;
+				attractor.on_period
+					= node["period"][0].as<fpmas::api::scheduler::TimeStep>();
+				attractor.off_period
+					= node["period"][1].as<fpmas::api::scheduler::TimeStep>();
+			}
+			return true;
+		}
 		// The root node contains 2 elements
 		if(!node.IsSequence() || node.size() != 2)
 			return false;
 		// The first is a point
-		if(!node[0].IsSequence() || node.size() != 2)
+		if(!decode_point(node[0], attractor.center))
 			return false;
 		// The second is the radius
 		if(!node[1].IsScalar())
 			return false;
+		attractor.radius = node[1].as<float>();
 
-		attractor.center = {
-			node[0][0].as<fpmas::api::model::DiscreteCoordinate>(),
-			node[0][1].as<fpmas::api::model::DiscreteCoordinate>(),
-		};
+		return true;
+	}
+
+	Node convert<GraphAttractor>::encode(const GraphAttractor& attractor) {
+		Node node;
+		node.push_back(attractor.cell_index);
+		node.push_back(attractor.radius);
+		return node;
+	}
+
+	bool convert<GraphAttractor>::decode(const Node &node, GraphAttractor& attractor) {
+		// The root node contains a cell index and a radius
+		if(!node.IsSequence() || node.size() != 2)
+			return false;
+		if(!node[0].IsScalar() || !node[1].IsScalar())
+			return false;
+
+		attractor.cell_index = node[0].as<std::size_t>();
 		attractor.radius = node[1].as<float>();
 
 		return true;
@@ -383,14 +924,18 @@ namespace YAML {
 		Node node;
 		node.push_back(test_case_config.algorithm);
 		node.push_back(test_case_config.lb_periods);
+		if(!test_case_config.plugin.empty())
+			node.push_back(test_case_config.plugin);
 		return node;
 	}
 
 	bool convert<TestCaseConfig>::decode(const Node &node, TestCaseConfig& test_case_config) {
-		if(!node.IsSequence() || node.size() != 2)
+		if(!node.IsSequence() || node.size() < 2 || node.size() > 3)
 			return false;
-		test_case_config.algorithm = node[0].as<LbAlgorithm>();
+		test_case_config.algorithm = node[0].as<std::string>();
 		test_case_config.lb_periods = node[1].as<std::vector<fpmas::api::scheduler::TimeStep>>();
+		if(node.size() == 3)
+			test_case_config.plugin = node[2].as<std::string>();
 		return true;
 	}
 }
@@ -0,0 +1,140 @@
+#include "ensemble.h"
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+
+std::vector<unsigned long> ensemble_seeds(unsigned long seed, std::size_t n) {
+	if(n == 1)
+		return {seed};
+	std::vector<std::seed_seq::result_type> seeds(n);
+	std::seed_seq seq({
+			(std::seed_seq::result_type) seed,
+			(std::seed_seq::result_type) (seed >> 32)
+			});
+	seq.generate(seeds.begin(), seeds.end());
+	return {seeds.begin(), seeds.end()};
+}
+
+/**
+ * Two-sided 97.5% quantiles of the Student's t-distribution, for 1 to 30
+ * degrees of freedom.
+ */
+static const double t_975[] = {
+	12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+	2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+	2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+/**
+ * Linearly interpolated quantile of sorted values.
+ */
+static double quantile(const std::vector<double>& sorted, double q) {
+	double position = q * (sorted.size() - 1);
+	std::size_t i = (std::size_t) position;
+	if(i + 1 >= sorted.size())
+		return sorted.back();
+	return sorted[i] + (position - i) * (sorted[i+1] - sorted[i]);
+}
+
+SampleStatistics sample_statistics(
+		std::vector<double> values, bool reject_outliers) {
+	SampleStatistics statistics;
+	if(values.empty())
+		return statistics;
+
+	std::sort(values.begin(), values.end());
+	if(reject_outliers && values.size() >= 4) {
+		double q1 = quantile(values, .25);
+		double q3 = quantile(values, .75);
+		double low = q1 - 1.5 * (q3 - q1);
+		double high = q3 + 1.5 * (q3 - q1);
+		values.erase(
+				std::remove_if(values.begin(), values.end(),
+					[low, high] (const double& value) {
+					return value < low || value > high;
+					}),
+				values.end());
+	}
+
+	statistics.count = values.size();
+	statistics.min = values.front();
+	for(auto& value : values)
+		statistics.mean += value;
+	statistics.mean /= values.size();
+
+	if(values.size() > 1) {
+		for(auto& value : values)
+			statistics.stddev
+				+= (value - statistics.mean) * (value - statistics.mean);
+		statistics.stddev = std::sqrt(statistics.stddev / (values.size() - 1));
+
+		std::size_t degrees = values.size() - 1;
+		double t = degrees <= 30 ? t_975[degrees-1] : 1.96;
+		statistics.ci95 = t * statistics.stddev / std::sqrt(values.size());
+	}
+	return statistics;
+}
+
+/**
+ * Splits a CSV line.
+ */
+static std::vector<std::string> split(const std::string& line) {
+	std::vector<std::string> fields;
+	std::istringstream stream(line);
+	std::string field;
+	while(std::getline(stream, field, ','))
+		fields.push_back(field);
+	return fields;
+}
+
+void aggregate_ensemble(
+		const std::vector<std::string>& csv_files,
+		const std::string& output_file,
+		bool reject_outliers) {
+	std::vector<std::string> header;
+	// rows[file][row][column]
+	std::vector<std::vector<std::vector<std::string>>> rows;
+	for(auto& csv_file : csv_files) {
+		std::ifstream csv(csv_file);
+		std::string line;
+		std::getline(csv, line);
+		header = split(line);
+		rows.emplace_back();
+		while(std::getline(csv, line))
+			if(!line.empty())
+				rows.back().push_back(split(line));
+	}
+	std::size_t row_count = rows.empty() ? 0 : rows[0].size();
+	for(auto& file_rows : rows)
+		row_count = std::min(row_count, file_rows.size());
+
+	std::ofstream output(output_file);
+	if(header.empty())
+		return;
+	output << header[0];
+	for(std::size_t j = 1; j < header.size(); j++)
+		output << "," << header[j] << "_MEAN"
+			<< "," << header[j] << "_STDDEV"
+			<< "," << header[j] << "_MIN"
+			<< "," << header[j] << "_CI95";
+	output << std::endl;
+
+	for(std::size_t i = 0; i < row_count; i++) {
+		output << rows[0][i][0];
+		for(std::size_t j = 1; j < header.size(); j++) {
+			std::vector<double> values;
+			for(auto& file_rows : rows)
+				if(j < file_rows[i].size())
+					values.push_back(std::stod(file_rows[i][j]));
+			SampleStatistics statistics
+				= sample_statistics(values, reject_outliers);
+			output << "," << statistics.mean
+				<< "," << statistics.stddev
+				<< "," << statistics.min
+				<< "," << statistics.ci95;
+		}
+		output << std::endl;
+	}
+}
@@ -0,0 +1,253 @@
+#include "estimate.h"
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <unistd.h>
+
+/**
+ * Computes the count of read and write operations performed at each time
+ * step by a cell or an agent with `degree` neighbors.
+ */
+static void interaction_counts(
+		Interactions interactions, double degree,
+		double& reads, double& writes) {
+	reads = 0;
+	writes = 0;
+	switch(interactions) {
+		case Interactions::READ_ALL:
+			reads = degree;
+			break;
+		case Interactions::READ_ONE:
+			reads = 1;
+			break;
+		case Interactions::WRITE_ALL:
+			writes = degree;
+			break;
+		case Interactions::WRITE_ONE:
+			writes = 1;
+			break;
+		case Interactions::READ_ALL_WRITE_ONE:
+			reads = degree;
+			writes = 1;
+			break;
+		case Interactions::READ_ALL_WRITE_ALL:
+			reads = degree;
+			writes = degree;
+			break;
+		case Interactions::READ_K:
+			reads = ReaderWriter::p * std::min((double) ReaderWriter::k, degree);
+			break;
+		case Interactions::WRITE_K:
+			writes = ReaderWriter::p * std::min((double) ReaderWriter::k, degree);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * Total count of cells in the environment.
+ */
+static double cell_count(const ModelConfig& config) {
+	return config.environment == Environment::GRID ?
+		config.grid_width * config.grid_height : config.num_cells;
+}
+
+ModelConfig sample_config(
+		const ModelConfig& config, int process_count,
+		std::size_t cells_per_process) {
+	ModelConfig sample = config;
+	double cells = cell_count(config);
+	double sample_cells
+		= std::min(cells, (double) cells_per_process * process_count);
+	switch(config.environment) {
+		case Environment::GRID:
+			{
+				double factor = std::sqrt(sample_cells / cells);
+				sample.grid_width = std::max(
+						(std::size_t) 1,
+						(std::size_t) std::round(config.grid_width * factor));
+				sample.grid_height = std::max(
+						(std::size_t) 1,
+						(std::size_t) std::round(config.grid_height * factor));
+			}
+			break;
+		default:
+			sample.num_cells = sample_cells;
+	}
+	sample.num_steps = 1;
+	sample.warmup_steps = 0;
+	sample.checkpoint_period = 0;
+	sample.json_output = false;
+	sample.dot_output = false;
+	sample.environment_snapshot = "";
+	return sample;
+}
+
+CostEstimate measure_costs(BasicMetaModel& model) {
+	CostEstimate costs;
+	fpmas::io::datapack::ObjectPack pack;
+
+	auto cells = model.cellGroup().localAgents();
+	costs.local_cells = cells.size();
+	costs.ghost_cells = model.cellGroup().distantAgents().size();
+	for(auto cell : cells) {
+		costs.cell_bytes += pack.size(cell->node()->data());
+		// Edges on which cell interactions are performed, that include
+		// CELL_INTERACTION edges within the interaction_range
+		for(auto edge : cell->node()->getOutgoingEdges(
+					MetaCell::interactionLayer())) {
+			costs.cell_edges++;
+			if(edge->getTargetNode()->state() == fpmas::api::graph::DISTANT)
+				costs.distant_cell_edges++;
+		}
+	}
+	if(cells.size() > 0)
+		costs.cell_bytes /= cells.size();
+
+	auto agents = model.agentGroup().localAgents();
+	costs.local_agents = agents.size();
+	costs.ghost_agents = model.agentGroup().distantAgents().size();
+	for(auto agent : agents) {
+		costs.agent_bytes += pack.size(agent->node()->data());
+		for(auto edge : agent->node()->getOutgoingEdges()) {
+			costs.agent_edges++;
+			if(edge->getTargetNode()->state() == fpmas::api::graph::DISTANT)
+				costs.distant_agent_edges++;
+		}
+	}
+	if(agents.size() > 0)
+		costs.agent_bytes /= agents.size();
+	return costs;
+}
+
+CostEstimate extrapolate_costs(
+		const CostEstimate& sample, const ModelConfig& sample_config,
+		const ModelConfig& config, int process_count) {
+	CostEstimate costs = sample;
+	double ratio = cell_count(config) / cell_count(sample_config);
+	// In a grid, ghosts are located at the border of each partition
+	double ghost_ratio = config.environment == Environment::GRID ?
+		std::sqrt(ratio) : ratio;
+
+	costs.local_cells *= ratio;
+	costs.local_agents *= ratio;
+	costs.ghost_cells *= ghost_ratio;
+	costs.ghost_agents *= ghost_ratio;
+	costs.cell_edges *= ratio;
+	costs.distant_cell_edges *= ghost_ratio;
+	costs.agent_edges *= ratio;
+	costs.distant_agent_edges *= ghost_ratio;
+
+	double sample_objects = sample.local_cells + sample.local_agents
+		+ sample.ghost_cells + sample.ghost_agents
+		+ sample.cell_edges + sample.agent_edges;
+	double bytes_per_object
+		= sample_objects > 0 ? sample.memory_bytes / sample_objects : 0;
+
+	fpmas::io::datapack::ObjectPack pack;
+	std::size_t id_bytes = pack.size(fpmas::api::graph::DistributedId());
+	// Read and write operations performed by each agent on its contacts at
+	// each time step
+	double contact_reads = 0;
+	double contact_writes = 0;
+	if(config.agent_interactions == AgentInteractions::CONTACTS) {
+		// Upper bound: all agents have max_contacts contacts, that are
+		// located on random processes
+		double max_contacts = MetaAgentBase::max_contacts;
+		if(!config.species.empty()) {
+			// Mean max_contacts of species
+			double total_fraction = 0;
+			max_contacts = 0;
+			for(auto& species : config.species) {
+				max_contacts += species.fraction * species.max_contacts;
+				total_fraction += species.fraction;
+			}
+			max_contacts /= total_fraction;
+		}
+		double contacts = costs.local_agents * max_contacts;
+		costs.agent_edges += contacts;
+		costs.distant_agent_edges
+			+= contacts * (process_count - 1) / process_count;
+		costs.agent_bytes += max_contacts * id_bytes;
+		interaction_counts(
+				MetaAgentBase::contact_interactions, max_contacts,
+				contact_reads, contact_writes);
+	}
+	costs.memory_bytes = bytes_per_object * (
+			costs.local_cells + costs.local_agents
+			+ costs.ghost_cells + costs.ghost_agents
+			+ costs.cell_edges + costs.agent_edges);
+
+	// Read and write operations performed by each cell at each time step
+	double degree = costs.local_cells > 0 ?
+		costs.cell_edges / costs.local_cells : 0;
+	double reads;
+	double writes;
+	interaction_counts(config.cell_interactions, degree, reads, writes);
+	double distant_fraction = costs.cell_edges > 0 ?
+		costs.distant_cell_edges / costs.cell_edges : 0;
+
+	costs.step_message_bytes = 0;
+	if(config.cell_interactions != Interactions::NONE) {
+		switch(config.sync_mode) {
+			case SyncMode::HARD_SYNC_MODE:
+				// A request and a response for each distant read, an
+				// acquire and a release for each distant write
+				costs.step_message_bytes
+					+= costs.local_cells * distant_fraction * (
+							reads * (id_bytes + costs.cell_bytes)
+							+ writes * 2 * (id_bytes + costs.cell_bytes));
+				break;
+			default:
+				// All ghost cells are updated at each synchronization
+				costs.step_message_bytes
+					+= costs.ghost_cells * costs.cell_bytes;
+		}
+	}
+	if(config.sync_mode == SyncMode::HARD_SYNC_MODE)
+		// Contacts are located on random processes. In ghost modes, ghost
+		// agents are already updated by the synchronization of the move
+		// group.
+		costs.step_message_bytes
+			+= costs.local_agents * (process_count - 1) / process_count * (
+					contact_reads * (id_bytes + costs.agent_bytes)
+					+ contact_writes * 2 * (id_bytes + costs.agent_bytes));
+	if(costs.local_agents > 0)
+		// Ghost agents are updated by the synchronization of the move
+		// group, and moving agents migrate edges to distant cells
+		costs.step_message_bytes += costs.ghost_agents * costs.agent_bytes
+			+ costs.distant_agent_edges * 2 * id_bytes;
+	return costs;
+}
+
+void write_estimate_header(std::ostream& output) {
+	output << "LOCAL_CELLS,LOCAL_AGENTS,GHOST_CELLS,GHOST_AGENTS,"
+		"CELL_EDGES,DISTANT_CELL_EDGES,AGENT_EDGES,DISTANT_AGENT_EDGES,"
+		"CELL_BYTES,AGENT_BYTES,MEMORY_BYTES,STEP_MESSAGE_BYTES"
+		<< std::endl;
+}
+
+void write_estimate(std::ostream& output, const CostEstimate& estimate) {
+	output << (std::size_t) estimate.local_cells << ","
+		<< (std::size_t) estimate.local_agents << ","
+		<< (std::size_t) estimate.ghost_cells << ","
+		<< (std::size_t) estimate.ghost_agents << ","
+		<< (std::size_t) estimate.cell_edges << ","
+		<< (std::size_t) estimate.distant_cell_edges << ","
+		<< (std::size_t) estimate.agent_edges << ","
+		<< (std::size_t) estimate.distant_agent_edges << ","
+		<< (std::size_t) estimate.cell_bytes << ","
+		<< (std::size_t) estimate.agent_bytes << ","
+		<< (std::size_t) estimate.memory_bytes << ","
+		<< (std::size_t) estimate.step_message_bytes << std::endl;
+}
+
+std::size_t resident_memory() {
+	std::ifstream statm("/proc/self/statm");
+	std::size_t size = 0;
+	std::size_t resident = 0;
+	if(!(statm >> size >> resident))
+		return 0;
+	return resident * sysconf(_SC_PAGESIZE);
+}
@@ -2,83 +2,225 @@
 
 fpmas::random::DistributedGenerator<> random_interactions;
 
-fpmas::utils::perf::Probe ReaderWriter::local_read_probe {
+ConcurrentProbe ReaderWriter::local_read_probe {
 	"LOCAL_READ"
 };
-fpmas::utils::perf::Probe ReaderWriter::distant_read_probe {
+ConcurrentProbe ReaderWriter::distant_read_probe {
 	"DISTANT_READ"
 };
 
-fpmas::utils::perf::Probe ReaderWriter::local_write_probe {
+ConcurrentProbe ReaderWriter::local_write_probe {
 	"LOCAL_WRITE"
 };
-fpmas::utils::perf::Probe ReaderWriter::distant_write_probe {
+ConcurrentProbe ReaderWriter::distant_write_probe {
 	"DISTANT_WRITE"
 };
+const InteractionProbes ReaderWriter::cell_probes {
+	local_read_probe, local_write_probe,
+	distant_read_probe, distant_write_probe
+};
+
+ConcurrentProbe ReaderWriter::contact_local_read_probe {
+	"CONTACT_LOCAL_READ"
+};
+ConcurrentProbe ReaderWriter::contact_distant_read_probe {
+	"CONTACT_DISTANT_READ"
+};
+
+ConcurrentProbe ReaderWriter::contact_local_write_probe {
+	"CONTACT_LOCAL_WRITE"
+};
+ConcurrentProbe ReaderWriter::contact_distant_write_probe {
+	"CONTACT_DISTANT_WRITE"
+};
+const InteractionProbes ReaderWriter::contact_probes {
+	contact_local_read_probe, contact_local_write_probe,
+	contact_distant_read_probe, contact_distant_write_probe
+};
+
+std::size_t ReaderWriter::k = 1;
+float ReaderWriter::p = 1.f;
+
+/**
+ * Returns the indexes of ReaderWriter::k neighbors randomly selected without
+ * replacement among `count` neighbors, or an empty list if the interaction is
+ * skipped with a probability `1-ReaderWriter::p`.
+ */
+static std::vector<std::size_t> select_k(std::size_t count) {
+	std::vector<std::size_t> indexes;
+	if(count == 0)
+		return indexes;
+	if(ReaderWriter::p < 1.f) {
+		fpmas::random::UniformRealDistribution<float> draw(0, 1);
+		if(draw(random_interactions) >= ReaderWriter::p)
+			return indexes;
+	}
+	indexes.resize(count);
+	for(std::size_t i = 0; i < count; i++)
+		indexes[i] = i;
+	std::size_t k = std::min(ReaderWriter::k, count);
+	// Partial Fisher-Yates shuffle: only the k first indexes are drawn
+	for(std::size_t i = 0; i < k; i++) {
+		fpmas::random::UniformIntDistribution<std::size_t> index(i, count-1);
+		std::swap(indexes[i], indexes[index(random_interactions)]);
+	}
+	indexes.resize(k);
+	return indexes;
+}
 
 void ReaderWriter::read_all(
-		const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors) {
+		const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
 	for(auto& neighbor : neighbors) {
-		fpmas::utils::perf::Probe& read_probe =
+		ConcurrentProbe& read_probe =
 			neighbor->node()->state() == fpmas::api::graph::LOCAL ?
-			local_read_probe : distant_read_probe;
+			probes.local_read : probes.distant_read;
 		read_probe.start();
 		{
 			fpmas::model::ReadGuard read(neighbor);
+			if(callbacks.read)
+				callbacks.read(neighbor);
 		}
 		read_probe.stop();
 	}
 }
 void ReaderWriter::write_all(
-		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors) {
+		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
 	for(auto& neighbor : neighbors) {
-		fpmas::utils::perf::Probe& write_probe =
+		ConcurrentProbe& write_probe =
 			neighbor->node()->state() == fpmas::api::graph::LOCAL ?
-			local_write_probe : distant_write_probe;
+			probes.local_write : probes.distant_write;
 		write_probe.start();
 		{
 			fpmas::model::AcquireGuard acq(neighbor);
+			if(callbacks.write)
+				callbacks.write(neighbor);
 		}
 		write_probe.stop();
 	}
 }
 void ReaderWriter::read_one(
-		const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors) {
+		const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
 	if(neighbors.count() > 0) {
 		const fpmas::api::model::Agent* neighbor
 			= neighbors.random(random_interactions);
-		fpmas::utils::perf::Probe& read_probe =
+		ConcurrentProbe& read_probe =
 			neighbor->node()->state() == fpmas::api::graph::LOCAL ?
-			local_read_probe : distant_read_probe;
+			probes.local_read : probes.distant_read;
 		read_probe.start();
 		{
 			fpmas::model::ReadGuard read(neighbor);
+			if(callbacks.read)
+				callbacks.read(neighbor);
 		}
 		read_probe.stop();
 	}
 }
 void ReaderWriter::write_one(
-		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors) {
+		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
 	if(neighbors.count() > 0) {
 		fpmas::api::model::Agent* neighbor = neighbors.random(random_interactions);
-		fpmas::utils::perf::Probe& write_probe =
+		ConcurrentProbe& write_probe =
 			neighbor->node()->state() == fpmas::api::graph::LOCAL ?
-			local_write_probe : distant_write_probe;
+			probes.local_write : probes.distant_write;
 		write_probe.start();
 		{
 			fpmas::model::AcquireGuard acq(neighbor);
+			if(callbacks.write)
+				callbacks.write(neighbor);
+		}
+		write_probe.stop();
+	}
+}
+void ReaderWriter::read_k(
+		const fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
+	for(std::size_t i : select_k(neighbors.count())) {
+		const fpmas::api::model::Agent* neighbor = neighbors[i];
+		ConcurrentProbe& read_probe =
+			neighbor->node()->state() == fpmas::api::graph::LOCAL ?
+			probes.local_read : probes.distant_read;
+		read_probe.start();
+		{
+			fpmas::model::ReadGuard read(neighbor);
+			if(callbacks.read)
+				callbacks.read(neighbor);
+		}
+		read_probe.stop();
+	}
+}
+void ReaderWriter::write_k(
+		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
+	for(std::size_t i : select_k(neighbors.count())) {
+		fpmas::api::model::Agent* neighbor = neighbors[i];
+		ConcurrentProbe& write_probe =
+			neighbor->node()->state() == fpmas::api::graph::LOCAL ?
+			probes.local_write : probes.distant_write;
+		write_probe.start();
+		{
+			fpmas::model::AcquireGuard acq(neighbor);
+			if(callbacks.write)
+				callbacks.write(neighbor);
 		}
 		write_probe.stop();
 	}
 }
 void ReaderWriter::read_all_write_all(
-		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors) {
-	read_all(neighbors);
-	write_all(neighbors);
+		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
+	read_all(neighbors, callbacks, probes);
+	write_all(neighbors, callbacks, probes);
 }
 void ReaderWriter::read_all_write_one(
-		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors) {
-	read_all(neighbors);
-	write_one(neighbors);
+		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
+	read_all(neighbors, callbacks, probes);
+	write_one(neighbors, callbacks, probes);
 }
 
+void ReaderWriter::interact(
+		Interactions interactions,
+		fpmas::model::Neighbors<fpmas::api::model::Agent>& neighbors,
+		const InteractionCallbacks& callbacks,
+		const InteractionProbes& probes) {
+	switch(interactions) {
+		case Interactions::READ_ALL:
+			read_all(neighbors, callbacks, probes);
+			break;
+		case Interactions::READ_ONE:
+			read_one(neighbors, callbacks, probes);
+			break;
+		case Interactions::WRITE_ALL:
+			write_all(neighbors, callbacks, probes);
+			break;
+		case Interactions::WRITE_ONE:
+			write_one(neighbors, callbacks, probes);
+			break;
+		case Interactions::READ_ALL_WRITE_ONE:
+			read_all_write_one(neighbors, callbacks, probes);
+			break;
+		case Interactions::READ_ALL_WRITE_ALL:
+			read_all_write_all(neighbors, callbacks, probes);
+			break;
+		case Interactions::READ_K:
+			read_k(neighbors, callbacks, probes);
+			break;
+		case Interactions::WRITE_K:
+			write_k(neighbors, callbacks, probes);
+			break;
+		default:
+			break;
+	}
+}
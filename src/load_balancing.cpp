@@ -0,0 +1,171 @@
+#include "load_balancing.h"
+#include <dlfcn.h>
+
+/**
+ * Generic LoadBalancingAlgorithm that owns a single load balancing instance.
+ */
+template<typename LoadBalancingType>
+class SingleLoadBalancing : public LoadBalancingAlgorithm {
+	private:
+		LoadBalancingType lb;
+
+	public:
+		template<typename... Args>
+			SingleLoadBalancing(Args&&... args)
+			: lb(std::forward<Args>(args)...) {
+			}
+
+		fpmas::api::model::LoadBalancing& loadBalancing() override {
+			return lb;
+		}
+};
+
+/**
+ * LoadBalancingAlgorithm that applies a load balancing algorithm on top of a
+ * ZoltanLoadBalancing instance.
+ */
+template<typename LoadBalancingType>
+class ZoltanBasedLoadBalancing : public LoadBalancingAlgorithm {
+	private:
+		ZoltanLoadBalancing zoltan_lb;
+		LoadBalancingType lb;
+
+	public:
+		template<typename... Args>
+			ZoltanBasedLoadBalancing(
+					const LoadBalancingContext& context, Args&&... args)
+			: zoltan_lb(
+					context.comm, context.lb_period,
+					context.config.zoltan_imbalance_tol),
+			lb(std::forward<Args>(args)..., zoltan_lb) {
+			}
+
+		fpmas::api::model::LoadBalancing& loadBalancing() override {
+			return lb;
+		}
+};
+
+/**
+ * ScheduledLoadBalancing, that requires extra scheduler and runtime
+ * parameters after the Zoltan instance.
+ */
+class ZoltanScheduledLoadBalancing : public LoadBalancingAlgorithm {
+	private:
+		ZoltanLoadBalancing zoltan_lb;
+		ScheduledLoadBalancing lb;
+
+	public:
+		ZoltanScheduledLoadBalancing(const LoadBalancingContext& context)
+			: zoltan_lb(
+					context.comm, context.lb_period,
+					context.config.zoltan_imbalance_tol),
+			lb(zoltan_lb, context.scheduler, context.runtime) {
+			}
+
+		fpmas::api::model::LoadBalancing& loadBalancing() override {
+			return lb;
+		}
+};
+
+/**
+ * LoadBalancingAlgorithm built by a plugin.
+ */
+class PluginLoadBalancing : public LoadBalancingAlgorithm {
+	private:
+		std::unique_ptr<fpmas::api::model::LoadBalancing> lb;
+
+	public:
+		PluginLoadBalancing(fpmas::api::model::LoadBalancing* lb)
+			: lb(lb) {
+			}
+
+		fpmas::api::model::LoadBalancing& loadBalancing() override {
+			return *lb;
+		}
+};
+
+std::map<std::string, LoadBalancingRegistry::Entry>&
+LoadBalancingRegistry::entries() {
+	static std::map<std::string, Entry> entries = {
+		{"SCHEDULED_LB", {
+			[] (const LoadBalancingContext& context) {
+				return new ZoltanScheduledLoadBalancing(context);
+			}, true}},
+		{"ZOLTAN_LB", {
+			[] (const LoadBalancingContext& context) {
+				return new SingleLoadBalancing<ZoltanLoadBalancing>(
+						context.comm, context.lb_period,
+						context.config.zoltan_imbalance_tol);
+			}, true}},
+		{"GRID_LB", {
+			[] (const LoadBalancingContext& context) {
+				return new SingleLoadBalancing<GridLoadBalancing>(
+						context.config.grid_width, context.config.grid_height,
+						context.comm);
+			}, false}},
+		{"ZOLTAN_CELL_LB", {
+			[] (const LoadBalancingContext& context) {
+				return new ZoltanBasedLoadBalancing<CellLoadBalancing>(
+						context, context.comm);
+			}, true}},
+		{"STATIC_ZOLTAN_CELL_LB", {
+			[] (const LoadBalancingContext& context) {
+				return new ZoltanBasedLoadBalancing<StaticCellLoadBalancing>(
+						context, context.comm);
+			}, true}},
+		{"RANDOM_LB", {
+			[] (const LoadBalancingContext& context) {
+				return new SingleLoadBalancing<RandomLoadBalancing>(
+						context.comm);
+			}, false}}
+	};
+	return entries;
+}
+
+void LoadBalancingRegistry::add(
+		std::string name, LoadBalancingFactory factory,
+		bool uses_imbalance_tol) {
+	entries()[name] = {factory, uses_imbalance_tol};
+}
+
+bool LoadBalancingRegistry::load(std::string name, std::string library_path) {
+	void* library = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if(library == nullptr) {
+		std::cerr << "[FATAL ERROR] Cannot load " << library_path << ": "
+			<< dlerror() << std::endl;
+		return false;
+	}
+	typedef fpmas::api::model::LoadBalancing* (*EntryPoint)(
+			const LoadBalancingContext&);
+	EntryPoint entry_point = (EntryPoint) dlsym(
+			library, METAMODEL_LOAD_BALANCING_SYMBOL);
+	if(entry_point == nullptr) {
+		std::cerr << "[FATAL ERROR] " << library_path << " does not define "
+			METAMODEL_LOAD_BALANCING_SYMBOL << std::endl;
+		dlclose(library);
+		return false;
+	}
+	// The plugin optionally declares if it relies on the
+	// zoltan_imbalance_tol parameter
+	typedef bool (*UsesImbalanceTol)();
+	UsesImbalanceTol uses_imbalance_tol = (UsesImbalanceTol) dlsym(
+			library, METAMODEL_LOAD_BALANCING_USES_IMBALANCE_TOL_SYMBOL);
+	add(name, [entry_point] (const LoadBalancingContext& context) {
+			return new PluginLoadBalancing(entry_point(context));
+			}, uses_imbalance_tol != nullptr && uses_imbalance_tol());
+	return true;
+}
+
+bool LoadBalancingRegistry::contains(std::string name) {
+	return entries().count(name) > 0;
+}
+
+bool LoadBalancingRegistry::usesImbalanceTol(std::string name) {
+	return entries().at(name).uses_imbalance_tol;
+}
+
+std::unique_ptr<LoadBalancingAlgorithm> LoadBalancingRegistry::build(
+		std::string name, const LoadBalancingContext& context) {
+	return std::unique_ptr<LoadBalancingAlgorithm>(
+			entries().at(name).factory(context));
+}
@@ -4,6 +4,18 @@ MetaModelFactory::MetaModelFactory(Environment environment, SyncMode sync_mode)
 	: environment(environment), sync_mode(sync_mode) {
 	}
 
+std::vector<GridAttractor> grid_attractors_at(
+		const ModelConfig& config, fpmas::scheduler::TimeStep time_step) {
+	std::vector<GridAttractor> attractors;
+	for(auto attractor : config.grid_attractors)
+		if(attractor.isActive(time_step)) {
+			attractor.center = attractor.centerAt(
+					time_step, config.grid_width, config.grid_height);
+			attractors.push_back(attractor);
+		}
+	return attractors;
+}
+
 #define BUILD_MODEL(MODEL, SYNCHRO)\
 	return new MODEL<fpmas::synchro::SYNCHRO>(\
 			name, config, scheduler, runtime,\
@@ -58,9 +58,14 @@ MetaModelCsvOutput::MetaModelCsvOutput(
 		fpmas::api::utils::perf::Probe& distant_read_probe,
 		fpmas::api::utils::perf::Probe& distant_write_probe,
 		fpmas::api::utils::perf::Probe& sync_probe,
+		fpmas::api::utils::perf::Probe& contact_local_read_probe,
+		fpmas::api::utils::perf::Probe& contact_local_write_probe,
+		fpmas::api::utils::perf::Probe& contact_distant_read_probe,
+		fpmas::api::utils::perf::Probe& contact_distant_write_probe,
+		fpmas::api::utils::perf::Probe& contact_sync_probe,
 		fpmas::api::utils::perf::Monitor& monitor) :
 		fpmas::io::FileOutput(
-				metamodel.getName() + ".%r.csv",
+				metamodel.getName() + ".%r.csv.part",
 				metamodel.getModel().getMpiCommunicator().getRank()),
 		fpmas::io::CsvOutput<
 			fpmas::scheduler::Date, // Time Step
@@ -79,7 +84,19 @@ MetaModelCsvOutput::MetaModelCsvOutput(
 			unsigned int, // DISTANT Cell->Cell read count
 			unsigned int, // DISTANT Cell->Cell write time
 			unsigned int, // DISTANT Cell->Cell write count
-			unsigned int // Sync time
+			unsigned int, // Sync time
+			std::size_t, // Population
+			std::size_t, // Cell bytes
+			unsigned int, // LOCAL Agent->Agent read time
+			unsigned int, // LOCAL Agent->Agent read count
+			unsigned int, // LOCAL Agent->Agent write time
+			unsigned int, // LOCAL Agent->Agent write count
+			unsigned int, // DISTANT Agent->Agent read time
+			unsigned int, // DISTANT Agent->Agent read count
+			unsigned int, // DISTANT Agent->Agent write time
+			unsigned int, // DISTANT Agent->Agent write count
+			unsigned int, // Contact sync time
+			std::size_t // Infected agents
 		>(*this,
 			{"TIME", [&metamodel] {return metamodel.getModel().runtime().currentDate();}},
 			{"BALANCE_TIME", [&monitor] {
@@ -173,12 +190,67 @@ MetaModelCsvOutput::MetaModelCsvOutput(
 			return std::chrono::duration_cast<std::chrono::microseconds>(
 					monitor.totalDuration("SYNC")
 					).count();
+			}},
+			{"POPULATION", [&metamodel] {
+			return metamodel.agentGroup().localAgents().size();
+			}},
+			{"CELL_BYTES", [&metamodel] {
+			std::size_t total_size = 0;
+			for(auto cell : metamodel.cellGroup().localAgents())
+				total_size += dynamic_cast<MetaCell*>(cell)->getData().size();
+			return total_size;
+			}},
+			{"LOCAL_CONTACT_READ_TIME", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("CONTACT_LOCAL_READ")
+					).count();
+			}},
+			{"LOCAL_CONTACT_READ_COUNT", [&monitor] {
+			return monitor.callCount("CONTACT_LOCAL_READ");
+			}},
+			{"LOCAL_CONTACT_WRITE_TIME", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("CONTACT_LOCAL_WRITE")
+					).count();
+			}},
+			{"LOCAL_CONTACT_WRITE_COUNT", [&monitor] {
+			return monitor.callCount("CONTACT_LOCAL_WRITE");
+			}},
+			{"DISTANT_CONTACT_READ_TIME", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("CONTACT_DISTANT_READ")
+					).count();
+			}},
+			{"DISTANT_CONTACT_READ_COUNT", [&monitor] {
+			return monitor.callCount("CONTACT_DISTANT_READ");
+			}},
+			{"DISTANT_CONTACT_WRITE_TIME", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("CONTACT_DISTANT_WRITE")
+					).count();
+			}},
+			{"DISTANT_CONTACT_WRITE_COUNT", [&monitor] {
+			return monitor.callCount("CONTACT_DISTANT_WRITE");
+			}},
+			{"CONTACT_SYNC", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("CONTACT_SYNC")
+					).count();
+			}},
+			{"INFECTED", [&metamodel] {
+			std::size_t infected = 0;
+			for(auto agent : metamodel.agentGroup().localAgents())
+				if(dynamic_cast<MetaAgentBase*>(agent)->infected())
+					infected++;
+			return infected;
 			}}
 	), commit_probes_task([
 		&lb_algorithm_probe, &graph_balance_probe,
 		&local_read_probe, &local_write_probe,
 		&distant_read_probe, &distant_write_probe,
-		&sync_probe, &monitor
+		&sync_probe, &contact_local_read_probe, &contact_local_write_probe,
+		&contact_distant_read_probe, &contact_distant_write_probe,
+		&contact_sync_probe, &monitor
 	] () {
 		monitor.commit(lb_algorithm_probe);
 		monitor.commit(graph_balance_probe);
@@ -187,12 +259,102 @@ MetaModelCsvOutput::MetaModelCsvOutput(
 		monitor.commit(distant_read_probe);
 		monitor.commit(distant_write_probe);
 		monitor.commit(sync_probe);
+		monitor.commit(contact_local_read_probe);
+		monitor.commit(contact_local_write_probe);
+		monitor.commit(contact_distant_read_probe);
+		monitor.commit(contact_distant_write_probe);
+		monitor.commit(contact_sync_probe);
 	}),
 	clear_monitor_task([&monitor] () {
 		monitor.clear();
 	}),
 	_jobs({commit_probes_job, this->job(), clear_monitor_job}){
 	}
+
+WarmupCsvOutput::WarmupCsvOutput(
+		BasicMetaModel& metamodel,
+		fpmas::scheduler::TimeStep warmup_steps,
+		fpmas::api::utils::perf::Probe& lb_algorithm_probe,
+		fpmas::api::utils::perf::Probe& graph_balance_probe,
+		fpmas::api::utils::perf::Probe& local_read_probe,
+		fpmas::api::utils::perf::Probe& local_write_probe,
+		fpmas::api::utils::perf::Probe& distant_read_probe,
+		fpmas::api::utils::perf::Probe& distant_write_probe,
+		fpmas::api::utils::perf::Probe& sync_probe,
+		fpmas::api::utils::perf::Probe& contact_local_read_probe,
+		fpmas::api::utils::perf::Probe& contact_local_write_probe,
+		fpmas::api::utils::perf::Probe& contact_distant_read_probe,
+		fpmas::api::utils::perf::Probe& contact_distant_write_probe,
+		fpmas::api::utils::perf::Probe& contact_sync_probe,
+		fpmas::api::utils::perf::Monitor& monitor) :
+		fpmas::io::FileOutput(
+				metamodel.getName() + ".warmup.%r.csv.part",
+				metamodel.getModel().getMpiCommunicator().getRank()),
+		fpmas::io::CsvOutput<
+			fpmas::scheduler::TimeStep, // Warm-up steps
+			unsigned int, // LB count
+			unsigned int, // Partitioning time
+			unsigned int, // Distribution time
+			unsigned int, // Sync time
+			std::size_t // Population
+		>(*this,
+			{"WARMUP_STEPS", [warmup_steps] {return warmup_steps;}},
+			{"LB_COUNT", [&monitor] {
+			return monitor.callCount("GRAPH_BALANCE");
+			}},
+			{"BALANCE_TIME", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("LB_ALGORITHM")
+					).count();
+			}},
+			{"DISTRIBUTE_TIME", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("GRAPH_BALANCE")
+						- monitor.totalDuration("LB_ALGORITHM")
+					).count();
+			}},
+			{"CELL_SYNC", [&monitor] {
+			return std::chrono::duration_cast<std::chrono::microseconds>(
+					monitor.totalDuration("SYNC")
+					).count();
+			}},
+			{"POPULATION", [&metamodel] {
+			return metamodel.agentGroup().localAgents().size();
+			}}
+	), commit_probes_task([
+		&lb_algorithm_probe, &graph_balance_probe,
+		&local_read_probe, &local_write_probe,
+		&distant_read_probe, &distant_write_probe,
+		&sync_probe, &contact_local_read_probe, &contact_local_write_probe,
+		&contact_distant_read_probe, &contact_distant_write_probe,
+		&contact_sync_probe, &monitor
+	] () {
+		// All probes are committed, so that warm-up measures are not
+		// reported by the MetaModelCsvOutput
+		monitor.commit(lb_algorithm_probe);
+		monitor.commit(graph_balance_probe);
+		monitor.commit(local_read_probe);
+		monitor.commit(local_write_probe);
+		monitor.commit(distant_read_probe);
+		monitor.commit(distant_write_probe);
+		monitor.commit(sync_probe);
+		monitor.commit(contact_local_read_probe);
+		monitor.commit(contact_local_write_probe);
+		monitor.commit(contact_distant_read_probe);
+		monitor.commit(contact_distant_write_probe);
+		monitor.commit(contact_sync_probe);
+	}) {
+	}
+
+void WarmupCsvOutput::dump() {
+	CsvOutput::dump();
+	this->get().flush();
+}
+
+std::size_t MetaModelCsvOutput::offset() {
+	this->get().flush();
+	return this->get().tellp();
+}
 	
 CellsLocationOutput::CellsLocationOutput(BasicMetaModel& meta_model,
 		std::string filename,
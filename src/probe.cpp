@@ -28,3 +28,23 @@ void SyncProbeTask::run() {
 	sync_probe.stop();
 }
 
+
+thread_local std::unordered_map<
+	const ConcurrentProbe*, std::chrono::steady_clock::time_point
+	> ConcurrentProbe::start_times;
+
+void ConcurrentProbe::start() {
+	start_times[this] = Clock::now();
+}
+
+void ConcurrentProbe::stop() {
+	auto duration = std::chrono::duration_cast<fpmas::api::utils::perf::Duration>(
+			Clock::now() - start_times[this]);
+	std::lock_guard<std::mutex> lock(mutex);
+	_durations.push_back(duration);
+}
+
+void ConcurrentProbe::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	_durations.clear();
+}
@@ -0,0 +1,90 @@
+#include "snapshot.h"
+#include "agent.h"
+#include "fpmas/io/breakpoint.h"
+#include "fpmas/model/serializer.h"
+#include <fstream>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::string environment_key(const ModelConfig& config, int process_count) {
+	YAML::Node node;
+	node["environment"] = config.environment;
+	switch(config.environment) {
+		case Environment::GRID:
+			node["grid_width"] = config.grid_width;
+			node["grid_height"] = config.grid_height;
+			break;
+		case Environment::SMALL_WORLD:
+			node["p"] = config.p;
+		default:
+			node["num_cells"] = config.num_cells;
+			node["output_degree"] = config.output_degree;
+	}
+	node["cell_weight"] = config.cell_weight;
+	node["cell_edge_weight"] = MetaCell::cell_edge_weight;
+	node["utility"] = config.utility;
+	node["grid_attractors"] = config.grid_attractors;
+	node["graph_attractors"] = config.graph_attractors;
+	node["cell_size"] = config.cell_size;
+	node["cell_size_distribution"] = config.cell_size_distribution;
+	node["cell_size_sigma"] = config.cell_size_sigma;
+	node["cell_kernel"] = MetaCell::cell_kernel;
+	node["interaction_range"] = MetaCell::interaction_range;
+	node["cell_workload"] = config.cell_workload;
+	node["agent_workload"] = config.agent_workload;
+	node["occupation_rate"] = config.occupation_rate;
+	node["agent_weight"] = config.agent_weight;
+	node["range_size"] = MetaAgentBase::range_size;
+	node["species"] = config.species;
+	// Determines groups to which cells are added
+	node["cell_group"] = config.cell_interactions != Interactions::NONE;
+	node["gossip_group"]
+		= MetaAgentBase::contact_interactions != Interactions::NONE;
+	node["initial_infected"] = MetaAgentBase::initial_infected;
+	// Determines birth dates of initial agents
+	node["lifespan"] = config.lifespan;
+	node["dynamic_cell_edge_weights"] = config.dynamic_cell_edge_weights;
+	node["seed"] = config.seed;
+	node["processes"] = process_count;
+
+	return config_hash(node);
+}
+
+EnvironmentSnapshot::EnvironmentSnapshot(
+		const ModelConfig& config,
+		fpmas::api::communication::MpiCommunicator& comm)
+	: comm(comm) {
+		// Ignores errors, notably if the directory already exists
+		mkdir(config.environment_snapshot.c_str(), 0755);
+		filename = config.environment_snapshot + "/env-"
+			+ environment_key(config, comm.getSize()) + "."
+			+ std::to_string(comm.getRank()) + ".bin";
+	}
+
+bool EnvironmentSnapshot::exists() const {
+	int missing = std::ifstream(filename).good() ? 0 : 1;
+	fpmas::communication::TypedMpi<int> int_mpi(comm);
+	return fpmas::communication::all_reduce(
+			int_mpi, missing, std::plus<int>()
+			) == 0;
+}
+
+void EnvironmentSnapshot::dump(const fpmas::api::model::Model& model) const {
+	// Groups of test cases might concurrently dump the same snapshot: each
+	// process writes to its own temporary file
+	std::string tmp_filename
+		= filename + "." + std::to_string(getpid()) + ".tmp";
+	{
+		std::ofstream file(tmp_filename, std::ios::binary);
+		fpmas::io::DatapackBreakpoint<fpmas::api::model::Model> breakpoint;
+		breakpoint.dump(file, model);
+	}
+	std::rename(tmp_filename.c_str(), filename.c_str());
+}
+
+void EnvironmentSnapshot::load(fpmas::api::model::Model& model) const {
+	std::ifstream file(filename, std::ios::binary);
+	fpmas::io::DatapackBreakpoint<fpmas::api::model::Model> breakpoint;
+	breakpoint.load(file, model);
+}
@@ -0,0 +1,123 @@
+#include "sweep.h"
+#include <iostream>
+#include <sstream>
+
+/**
+ * Sets the field at the specified dot-separated path.
+ */
+static void set_field(
+		YAML::Node node, const std::vector<std::string>& path, std::size_t i,
+		const YAML::Node& value) {
+	if(i == path.size() - 1)
+		node[path[i]] = YAML::Clone(value);
+	else
+		set_field(node[path[i]], path, i+1, value);
+}
+
+static std::vector<std::string> split_path(const std::string& field) {
+	std::vector<std::string> path;
+	std::istringstream stream(field);
+	std::string part;
+	while(std::getline(stream, part, '.'))
+		path.push_back(part);
+	return path;
+}
+
+/**
+ * Builds a sweep point from the index of the value of each field.
+ */
+static SweepPoint build_point(
+		const YAML::Node& config,
+		const std::vector<std::pair<std::string, YAML::Node>>& fields,
+		const std::vector<std::size_t>& indexes) {
+	SweepPoint point;
+	point.config = YAML::Clone(config);
+	point.config.remove("sweep");
+	for(std::size_t i = 0; i < fields.size(); i++) {
+		const YAML::Node& value = fields[i].second[indexes[i]];
+		std::vector<std::string> path = split_path(fields[i].first);
+		set_field(point.config, path, 0, value);
+
+		std::string value_name = value.IsScalar() ?
+			value.Scalar() : "#" + std::to_string(indexes[i]);
+		point.parameters.push_back({fields[i].first, value_name});
+		if(!point.name.empty())
+			point.name += "+";
+		point.name += path.back() + "=" + value_name;
+	}
+	return point;
+}
+
+std::vector<SweepPoint> expand_sweep(const YAML::Node& config) {
+	if(!config["sweep"].IsDefined())
+		return {{config, "", {}}};
+
+	YAML::Node sweep = config["sweep"];
+	std::string mode = sweep["mode"].IsDefined() ?
+		sweep["mode"].as<std::string>() : "PRODUCT";
+	if(mode != "PRODUCT" && mode != "ZIP") {
+		std::cerr << "[FATAL ERROR] Bad sweep::mode field parsing. "
+			"Expected PRODUCT or ZIP" << std::endl;
+		return {};
+	}
+	if(!sweep["fields"].IsMap() || sweep["fields"].size() == 0) {
+		std::cerr << "[FATAL ERROR] sweep::fields must be a map of lists of "
+			"values" << std::endl;
+		return {};
+	}
+
+	std::vector<std::pair<std::string, YAML::Node>> fields;
+	for(auto field : sweep["fields"]) {
+		if(!field.second.IsSequence() || field.second.size() == 0) {
+			std::cerr << "[FATAL ERROR] sweep::fields::"
+				<< field.first.as<std::string>()
+				<< " must be a non empty list of values" << std::endl;
+			return {};
+		}
+		fields.push_back({field.first.as<std::string>(), field.second});
+	}
+
+	std::vector<SweepPoint> points;
+	std::vector<std::size_t> indexes(fields.size(), 0);
+	if(mode == "ZIP") {
+		for(auto& field : fields)
+			if(field.second.size() != fields[0].second.size()) {
+				std::cerr << "[FATAL ERROR] All sweep::fields lists must have "
+					"the same size in ZIP mode" << std::endl;
+				return {};
+			}
+		for(std::size_t i = 0; i < fields[0].second.size(); i++) {
+			std::fill(indexes.begin(), indexes.end(), i);
+			points.push_back(build_point(config, fields, indexes));
+		}
+	} else {
+		while(true) {
+			points.push_back(build_point(config, fields, indexes));
+			// Increments indexes as a mixed radix counter, the last field
+			// varying the fastest
+			std::size_t i = fields.size();
+			while(i > 0 && ++indexes[i-1] == fields[i-1].second.size()) {
+				indexes[i-1] = 0;
+				i--;
+			}
+			if(i == 0)
+				break;
+		}
+	}
+	return points;
+}
+
+void write_sweep_index(
+		std::ostream& output, const std::vector<SweepPoint>& sweep) {
+	output << "NAME";
+	if(!sweep.empty())
+		for(auto& parameter : sweep[0].parameters)
+			output << "," << parameter.first;
+	output << std::endl;
+	for(auto& point : sweep) {
+		output << point.name;
+		for(auto& parameter : point.parameters)
+			output << "," << parameter.second;
+		output << std::endl;
+	}
+}
@@ -0,0 +1,106 @@
+#include "thread_pool.h"
+
+thread_local std::size_t ThreadPool::_thread_index = 0;
+
+ThreadPool::ThreadPool(std::size_t size) {
+	if(size == 0)
+		size = 1;
+	for(std::size_t i = 0; i < size; i++)
+		queues.emplace_back(new Queue);
+	for(std::size_t i = 1; i < size; i++)
+		threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop = true;
+	}
+	start_condition.notify_all();
+	for(auto& thread : threads)
+		thread.join();
+}
+
+bool ThreadPool::pop(std::size_t thread_index, Chunk& chunk) {
+	{
+		// Own queue, last in first out
+		Queue& queue = *queues[thread_index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(!queue.chunks.empty()) {
+			chunk = queue.chunks.back();
+			queue.chunks.pop_back();
+			return true;
+		}
+	}
+	for(std::size_t i = 1; i < queues.size(); i++) {
+		// Steals from other queues, first in first out
+		Queue& queue = *queues[(thread_index + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(!queue.chunks.empty()) {
+			chunk = queue.chunks.front();
+			queue.chunks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::work(std::size_t thread_index) {
+	Chunk chunk;
+	while(pop(thread_index, chunk)) {
+		for(std::size_t i = chunk.first; i < chunk.second; i++)
+			task(i);
+		std::lock_guard<std::mutex> lock(mutex);
+		if(--remaining_chunks == 0)
+			done_condition.notify_all();
+	}
+}
+
+void ThreadPool::workerLoop(std::size_t thread_index) {
+	_thread_index = thread_index;
+	std::size_t last_generation = 0;
+	while(true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			start_condition.wait(lock, [this, last_generation] {
+					return stop || generation != last_generation;
+					});
+			if(stop)
+				return;
+			last_generation = generation;
+		}
+		work(thread_index);
+	}
+}
+
+void ThreadPool::parallelFor(
+		std::size_t count, std::function<void(std::size_t)> task,
+		std::size_t grain_size) {
+	if(queues.size() == 1 || count <= 1) {
+		for(std::size_t i = 0; i < count; i++)
+			task(i);
+		return;
+	}
+	if(grain_size == 0)
+		grain_size = count / (8 * queues.size()) + 1;
+
+	std::size_t chunk_count = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->task = task;
+		for(std::size_t begin = 0; begin < count; begin += grain_size) {
+			Queue& queue = *queues[chunk_count % queues.size()];
+			std::lock_guard<std::mutex> queue_lock(queue.mutex);
+			queue.chunks.push_back({begin, std::min(begin + grain_size, count)});
+			chunk_count++;
+		}
+		remaining_chunks = chunk_count;
+		generation++;
+	}
+	start_condition.notify_all();
+
+	work(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done_condition.wait(lock, [this] {return remaining_chunks == 0;});
+}
@@ -0,0 +1,81 @@
+#include "workload.h"
+#include "fpmas.h"
+#include <array>
+#include <cmath>
+
+float workload_kernel(float flops) {
+	// Independent lanes, that can be processed in a single vector register
+	constexpr std::size_t lanes = 16;
+	std::array<float, lanes> x;
+	for(std::size_t i = 0; i < lanes; i++)
+		x[i] = 1.f + i * 1e-3f;
+
+	// 2 operations per lane and per iteration
+	std::size_t iterations = (std::size_t) (flops / (2 * lanes));
+	for(std::size_t n = 0; n < iterations; n++)
+		for(std::size_t i = 0; i < lanes; i++)
+			x[i] = x[i] * 0.999999f + 1e-6f;
+
+	float result = 0;
+	for(std::size_t i = 0; i < lanes; i++)
+		result += x[i];
+	// Prevents the loop from being optimized out
+	static thread_local volatile float sink;
+	sink = result;
+	return result;
+}
+
+float draw_workload(const Workload& workload, float utility, float mean_utility) {
+	switch(workload.distribution) {
+		case WorkloadDistribution::UNIFORM:
+			return fpmas::random::UniformRealDistribution<float>(
+					0, 2 * workload.flops)(fpmas::model::RandomNeighbors::rd);
+		case WorkloadDistribution::PARETO:
+			{
+				// Inverse transform sampling, with a scale such that the mean
+				// is flops
+				float scale = workload.flops * (workload.alpha - 1) / workload.alpha;
+				float u = fpmas::random::UniformRealDistribution<float>(0, 1)(
+						fpmas::model::RandomNeighbors::rd);
+				return scale / std::pow(1 - u, 1 / workload.alpha);
+			}
+		case WorkloadDistribution::UTILITY:
+			return mean_utility > 0 ?
+				workload.flops * utility / mean_utility : workload.flops;
+		default:
+			return workload.flops;
+	}
+}
+
+float workload_weight(
+		float base_weight, const Workload& workload, float instance_workload) {
+	if(workload.flops <= 0)
+		return base_weight;
+	return base_weight * instance_workload / workload.flops;
+}
+
+std::size_t draw_cell_size(
+		CellSizeDistribution distribution, std::size_t cell_size, float sigma,
+		float utility, float mean_utility) {
+	switch(distribution) {
+		case CellSizeDistribution::UNIFORM:
+			return fpmas::random::UniformIntDistribution<std::size_t>(
+					0, 2 * cell_size)(fpmas::model::RandomNeighbors::rd);
+		case CellSizeDistribution::LOGNORMAL:
+			{
+				if(cell_size == 0)
+					return 0;
+				// mu is chosen so that the mean is cell_size
+				double mu = std::log((double) cell_size) - sigma * sigma / 2;
+				double x = fpmas::random::NormalDistribution<double>(mu, sigma)(
+						fpmas::model::RandomNeighbors::rd);
+				return (std::size_t) std::llround(std::exp(x));
+			}
+		case CellSizeDistribution::UTILITY:
+			return mean_utility > 0 ?
+				(std::size_t) std::llround(cell_size * utility / mean_utility)
+				: cell_size;
+		default:
+			return cell_size;
+	}
+}
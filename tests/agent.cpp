@@ -6,7 +6,9 @@ using namespace testing;
 TEST(MetaAgent, datapack) {
 	std::deque<DistributedId> contacts = {{0, 10}, {3, 4}, {12, 0}};
 
-	fpmas::api::model::AgentPtr agent_ptr(new MetaGridAgent(contacts));
+	MetaGridAgent* agent = new MetaGridAgent(contacts, 7, 2);
+	agent->setInfected(false, true);
+	fpmas::api::model::AgentPtr agent_ptr(agent);
 	fpmas::io::datapack::ObjectPack pack = agent_ptr;
 
 	fpmas::api::model::AgentPtr unserial_agent = pack.get<fpmas::api::model::AgentPtr>();
@@ -15,5 +17,31 @@ TEST(MetaAgent, datapack) {
 			static_cast<const MetaGridAgent*>(unserial_agent.get())->contacts(),
 			ElementsAreArray(contacts)
 			);
-			
+	ASSERT_EQ(
+			static_cast<const MetaGridAgent*>(unserial_agent.get())->birthDate(),
+			7);
+	ASSERT_EQ(
+			static_cast<const MetaGridAgent*>(unserial_agent.get())->species(),
+			2);
+	ASSERT_FALSE(
+			static_cast<const MetaGridAgent*>(unserial_agent.get())->infected());
+	ASSERT_TRUE(
+			static_cast<const MetaGridAgent*>(unserial_agent.get())->nextInfected());
+}
+
+TEST(MetaAgent, commit_infection) {
+	MetaGridAgent agent;
+	agent.infect();
+	ASSERT_FALSE(agent.infected());
+
+	agent.commitInfection(true);
+	// Newly infected agents can't recover before being infected
+	ASSERT_TRUE(agent.infected());
+
+	agent.commitInfection(false);
+	ASSERT_TRUE(agent.infected());
+
+	agent.commitInfection(true);
+	ASSERT_FALSE(agent.infected());
+	ASSERT_FALSE(agent.nextInfected());
 }
@@ -0,0 +1,21 @@
+#include "autotune.h"
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+TEST(Autotune, tune) {
+	// Minimum at lb_period=10 and imbalance_tol=1.2
+	Autotune autotune([] (
+				fpmas::api::scheduler::TimeStep lb_period, float imbalance_tol,
+				fpmas::api::scheduler::TimeStep steps) {
+			return steps * (
+					std::abs((double) lb_period - 10) + 1
+					+ (imbalance_tol - 1.2) * (imbalance_tol - 1.2));
+			});
+
+	ASSERT_EQ(autotune.tuneLbPeriod({50, 1, 10, 5, 20}, 1.1, 10, 1000), 10);
+	ASSERT_NEAR(autotune.tuneImbalanceTol(1.01, 1.5, 10, 20), 1.2, 0.01);
+	ASSERT_EQ(autotune.bestLbPeriod(), 10);
+	// 5 + 3 + 2 LB_PERIOD trials, 11 IMBALANCE_TOL trials
+	ASSERT_THAT(autotune.trace(), SizeIs(21));
+}
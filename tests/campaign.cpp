@@ -0,0 +1,40 @@
+#include "campaign.h"
+#include "gmock/gmock.h"
+#include <cstdio>
+
+using namespace testing;
+
+TEST(CampaignManifest, resume) {
+	std::string filename = "test-campaign.manifest.csv";
+	std::remove(filename.c_str());
+	CampaignEntry run {"ZOLTAN_LB-10", "abcd", 42, "ZOLTAN_LB", 10, RunStatus::RUNNING};
+	{
+		CampaignManifest manifest(filename);
+		manifest.update(run);
+		ASSERT_FALSE(manifest.complete(run));
+		ASSERT_TRUE(manifest.running(run));
+		CampaignEntry other_run = run;
+		other_run.config_hash = "abce";
+		ASSERT_FALSE(manifest.running(other_run));
+		run.status = RunStatus::COMPLETE;
+		manifest.update(run);
+		ASSERT_FALSE(manifest.running(run));
+		ASSERT_THAT(manifest.runs(), SizeIs(1));
+	}
+
+	CampaignManifest manifest(filename);
+	ASSERT_THAT(manifest.runs(), SizeIs(1));
+	ASSERT_TRUE(manifest.complete(run));
+
+	CampaignEntry other_seed = run;
+	other_seed.seed = 43;
+	ASSERT_FALSE(manifest.complete(other_seed));
+	CampaignEntry other_config = run;
+	other_config.config_hash = "abce";
+	ASSERT_FALSE(manifest.complete(other_config));
+
+	ASSERT_THAT(manifest.completeRun("abcd", 42), NotNull());
+	ASSERT_EQ(manifest.completeRun("abcd", 42)->name, run.name);
+	ASSERT_THAT(manifest.completeRun("abcd", 43), IsNull());
+	std::remove(filename.c_str());
+}
@@ -0,0 +1,31 @@
+#include "cell.h"
+#include "fpmas.h"
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+TEST(MetaCell, link_interaction_range) {
+	// Chain of cells: 0 -> 1 -> 2 -> 3 -> 4 -> 5
+	fpmas::model::Model<fpmas::synchro::GhostMode> model;
+	auto& group = model.buildGroup(0);
+	std::vector<MetaGraphCell*> cells;
+	for(std::size_t i = 0; i < 6; i++) {
+		cells.push_back(new MetaGraphCell(1.f, 1));
+		group.add(cells.back());
+	}
+	for(std::size_t i = 0; i < cells.size()-1; i++)
+		model.link(cells[i], cells[i+1], fpmas::api::model::CELL_SUCCESSOR);
+	model.graph().synchronize();
+
+	link_interaction_range(model, group, 2);
+
+	for(std::size_t i = 0; i < cells.size(); i++) {
+		std::vector<DistributedId> targets;
+		for(auto edge : cells[i]->node()->getOutgoingEdges(CELL_INTERACTION))
+			targets.push_back(edge->getTargetNode()->getId());
+		std::vector<DistributedId> expected;
+		for(std::size_t j = i+1; j < std::min(i+3, cells.size()); j++)
+			expected.push_back(cells[j]->node()->getId());
+		ASSERT_THAT(targets, UnorderedElementsAreArray(expected));
+	}
+}
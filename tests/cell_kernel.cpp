@@ -0,0 +1,89 @@
+#include "cell_kernel.h"
+#include "cell.h"
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+TEST(CellKernel, diffusion) {
+	std::vector<char> data = {10, 20, 30};
+	std::vector<std::uint32_t> sums(data.size(), 0);
+	cell_kernel_accumulate(CellKernel::DIFFUSION, sums, {20, 40, 60});
+	cell_kernel_accumulate(CellKernel::DIFFUSION, sums, {30, 60});
+
+	std::vector<char> next;
+	cell_kernel_update(CellKernel::DIFFUSION, data, sums, 2, next);
+	ASSERT_THAT(next, ElementsAre(20, 40, 30));
+
+	cell_kernel_write(CellKernel::DIFFUSION, data, {20, 40, 60});
+	ASSERT_THAT(data, ElementsAre(15, 30, 45));
+}
+
+TEST(CellKernel, game_of_life) {
+	// Dead with 3 neighbors, alive with 2 neighbors, alive with 1 neighbor
+	std::vector<char> data = {0, 1, 1};
+	std::vector<std::uint32_t> sums(data.size(), 0);
+	cell_kernel_accumulate(CellKernel::GAME_OF_LIFE, sums, {1, 1, 1});
+	cell_kernel_accumulate(CellKernel::GAME_OF_LIFE, sums, {1, 1, 0});
+	cell_kernel_accumulate(CellKernel::GAME_OF_LIFE, sums, {3, 0, 0});
+
+	std::vector<char> next;
+	cell_kernel_update(CellKernel::GAME_OF_LIFE, data, sums, 3, next);
+	ASSERT_THAT(next, ElementsAre(1, 1, 0));
+}
+
+TEST(CellKernel, merge) {
+	std::vector<char> base = {10, 20, 0, 1};
+	std::vector<char> data = {30, 10, 1, 1};
+	std::vector<char> next = {15, 15, 0, 0};
+	cell_kernel_merge(CellKernel::DIFFUSION, base, data, next);
+	ASSERT_THAT(next, ElementsAre(35, 5, 1, 0));
+
+	next = {0, 1, 0, 0};
+	cell_kernel_merge(CellKernel::GAME_OF_LIFE, base, data, next);
+	ASSERT_THAT(next, ElementsAre(0, 1, 1, 0));
+}
+
+/**
+ * Exposes the kernel interaction of MetaGridCells.
+ */
+class KernelCell : public MetaGridCell {
+	public:
+		using MetaGridCell::MetaGridCell;
+		using MetaCell::kernelInteraction;
+};
+
+TEST(CellKernel, assignment_preserves_next_state) {
+	MetaCell::cell_kernel = CellKernel::DIFFUSION;
+	KernelCell cell({0, 0}, 1.f, std::vector<char>({10, 20}));
+	MetaGridCell neighbor({0, 1}, 1.f, std::vector<char>({30, 40}));
+	cell.kernelInteraction([&neighbor] (const InteractionCallbacks& callbacks) {
+			callbacks.read(&neighbor);
+			});
+
+	// As when the cell is released by a distant process in HARD_SYNC_MODE
+	static_cast<MetaGridCell&>(cell)
+		= MetaGridCell({0, 0}, 1.f, std::vector<char>({10, 20}));
+	cell.commitState();
+	MetaCell::cell_kernel = CellKernel::NONE;
+
+	ASSERT_THAT(cell.getData(), ElementsAre(20, 30));
+}
+
+TEST(CellKernel, commit_preserves_writes) {
+	MetaCell::cell_kernel = CellKernel::DIFFUSION;
+	KernelCell cell({0, 0}, 1.f, std::vector<char>({10, 20}));
+	MetaGridCell neighbor({0, 1}, 1.f, std::vector<char>({30, 40}));
+	KernelCell writer({1, 0}, 1.f, std::vector<char>({50, 60}));
+	cell.kernelInteraction([&neighbor] (const InteractionCallbacks& callbacks) {
+			callbacks.read(&neighbor);
+			});
+	// Written once its next state is computed, as in READ_ALL_WRITE_ALL
+	writer.kernelInteraction([&cell] (const InteractionCallbacks& callbacks) {
+			callbacks.write(&cell);
+			});
+	cell.commitState();
+	MetaCell::cell_kernel = CellKernel::NONE;
+
+	// Next state {20, 30}, plus the variation {20, 20} caused by the write
+	ASSERT_THAT(cell.getData(), ElementsAre(40, 50));
+}
@@ -0,0 +1,33 @@
+#include "ensemble.h"
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+TEST(Ensemble, seeds) {
+	ASSERT_THAT(ensemble_seeds(42, 1), ElementsAre(42));
+
+	auto seeds = ensemble_seeds(42, 8);
+	ASSERT_THAT(seeds, SizeIs(8));
+	ASSERT_THAT(ensemble_seeds(42, 8), ElementsAreArray(seeds));
+	ASSERT_THAT(ensemble_seeds(43, 8), Not(ElementsAreArray(seeds)));
+}
+
+TEST(Ensemble, statistics) {
+	SampleStatistics statistics
+		= sample_statistics({2, 4, 4, 4, 5, 5, 7, 9}, false);
+
+	ASSERT_EQ(statistics.count, 8);
+	ASSERT_DOUBLE_EQ(statistics.mean, 5);
+	ASSERT_DOUBLE_EQ(statistics.min, 2);
+	ASSERT_NEAR(statistics.stddev, 2.138, 1e-3);
+	ASSERT_NEAR(statistics.ci95, 2.365 * 2.138 / std::sqrt(8), 1e-3);
+}
+
+TEST(Ensemble, reject_outliers) {
+	SampleStatistics statistics
+		= sample_statistics({10, 11, 10, 12, 11, 100}, true);
+
+	ASSERT_EQ(statistics.count, 5);
+	ASSERT_DOUBLE_EQ(statistics.mean, 10.8);
+	ASSERT_DOUBLE_EQ(statistics.min, 10);
+}
@@ -17,6 +17,9 @@ int main(int argc, char **argv) {
 			MetaGraphCell::JsonBase,
 			MetaGraphAgent::JsonBase
 			);
+	fpmas::init(argc, argv);
 	::testing::InitGoogleTest(&argc, argv);
-	return RUN_ALL_TESTS();
+	int result = RUN_ALL_TESTS();
+	fpmas::finalize();
+	return result;
 }
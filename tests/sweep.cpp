@@ -0,0 +1,51 @@
+#include "sweep.h"
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+TEST(Sweep, no_sweep) {
+	YAML::Node config = YAML::Load("occupation_rate: 0.5");
+	auto sweep = expand_sweep(config);
+
+	ASSERT_THAT(sweep, SizeIs(1));
+	ASSERT_EQ(sweep[0].name, "");
+	ASSERT_EQ(sweep[0].config["occupation_rate"].as<float>(), 0.5);
+}
+
+TEST(Sweep, product) {
+	YAML::Node config = YAML::Load(
+			"occupation_rate: 0.5\n"
+			"MetaAgentBase: {range_size: 1}\n"
+			"sweep:\n"
+			"  fields:\n"
+			"    occupation_rate: [0.1, 0.2]\n"
+			"    MetaAgentBase.range_size: [1, 2, 3]\n"
+			);
+	auto sweep = expand_sweep(config);
+
+	ASSERT_THAT(sweep, SizeIs(6));
+	ASSERT_EQ(sweep[4].name, "occupation_rate=0.2+range_size=2");
+	ASSERT_FALSE(sweep[4].config["sweep"].IsDefined());
+	ASSERT_EQ(sweep[4].config["occupation_rate"].as<float>(), 0.2f);
+	ASSERT_EQ(sweep[4].config["MetaAgentBase"]["range_size"].as<int>(), 2);
+	// The original configuration is not modified
+	ASSERT_EQ(config["MetaAgentBase"]["range_size"].as<int>(), 1);
+}
+
+TEST(Sweep, zip) {
+	YAML::Node config = YAML::Load(
+			"sweep:\n"
+			"  mode: ZIP\n"
+			"  fields:\n"
+			"    occupation_rate: [0.1, 0.2]\n"
+			"    grid_attractors: [[[1, 2, 3]], []]\n"
+			);
+	auto sweep = expand_sweep(config);
+
+	ASSERT_THAT(sweep, SizeIs(2));
+	ASSERT_EQ(sweep[1].name, "occupation_rate=0.2+grid_attractors=#1");
+	ASSERT_EQ(sweep[1].config["grid_attractors"].size(), 0);
+
+	config["sweep"]["fields"]["occupation_rate"].push_back(0.3);
+	ASSERT_THAT(expand_sweep(config), IsEmpty());
+}
@@ -0,0 +1,27 @@
+#include "thread_pool.h"
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+TEST(ThreadPool, parallel_for) {
+	ThreadPool thread_pool(4);
+	std::vector<int> counts(1000, 0);
+	std::vector<std::size_t> threads(counts.size());
+
+	thread_pool.parallelFor(counts.size(), [&] (std::size_t i) {
+			counts[i]++;
+			threads[i] = ThreadPool::threadIndex();
+			});
+
+	ASSERT_THAT(counts, Each(1));
+	ASSERT_THAT(threads, Each(Lt(4)));
+}
+
+TEST(ThreadPool, sequential) {
+	ThreadPool thread_pool(1);
+	std::vector<std::size_t> order;
+
+	thread_pool.parallelFor(10, [&] (std::size_t i) {order.push_back(i);});
+
+	ASSERT_THAT(order, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
@@ -0,0 +1,45 @@
+#include "workload.h"
+#include "fpmas.h"
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+static float mean_workload(const Workload& workload) {
+	float sum = 0;
+	for(std::size_t i = 0; i < 100000; i++)
+		sum += draw_workload(workload, 1, 1);
+	return sum / 100000;
+}
+
+TEST(Workload, distributions) {
+	Workload workload;
+	workload.flops = 1000;
+	ASSERT_FLOAT_EQ(draw_workload(workload, 2, 1), 1000);
+
+	workload.distribution = WorkloadDistribution::UTILITY;
+	ASSERT_FLOAT_EQ(draw_workload(workload, 2, 1), 2000);
+
+	workload.distribution = WorkloadDistribution::UNIFORM;
+	ASSERT_NEAR(mean_workload(workload), 1000, 20);
+
+	workload.distribution = WorkloadDistribution::PARETO;
+	workload.alpha = 3;
+	ASSERT_NEAR(mean_workload(workload), 1000, 50);
+}
+
+TEST(Workload, weight) {
+	Workload workload;
+	ASSERT_FLOAT_EQ(workload_weight(2, workload, 0), 2);
+	workload.flops = 1000;
+	ASSERT_FLOAT_EQ(workload_weight(2, workload, 500), 1);
+}
+
+TEST(Workload, cell_size) {
+	ASSERT_EQ(draw_cell_size(CellSizeDistribution::CONSTANT, 100, 1, 2, 1), 100);
+	ASSERT_EQ(draw_cell_size(CellSizeDistribution::UTILITY, 100, 1, 2, 1), 200);
+
+	double sum = 0;
+	for(std::size_t i = 0; i < 100000; i++)
+		sum += draw_cell_size(CellSizeDistribution::LOGNORMAL, 1000, 0.5, 1, 1);
+	ASSERT_NEAR(sum / 100000, 1000, 20);
+}